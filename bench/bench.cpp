@@ -0,0 +1,288 @@
+/**
+ * @file bench.cpp
+ *
+ * @brief Compiler throughput benchmark
+ *
+ * Generates synthetic programs of growing size for every scenario and measures every compiler phase separately
+ * (best time of several iterations). Time per token of the phase should stay the same for all scales of scenario,
+ * growth of it shows where the phase stops scaling linearly
+ */
+
+#include "../include/optimizer/optimizer.hpp"
+#include "../include/semantic/semantic.hpp"
+#include "../include/codegen/codegen.hpp"
+#include "../include/parser/parser.hpp"
+#include "../include/target/target.hpp"
+#include "../include/lexer/lexer.hpp"
+#include "generator.hpp"
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/ADT/SmallVector.h>
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Phases of compilation
+ */
+enum Phase : uint8_t {
+    PHASE_LEX,
+    PHASE_PARSE,
+    PHASE_SEMANTIC,
+    PHASE_CODEGEN,
+    PHASE_OPTIMIZE,
+    PHASE_EMIT,
+    PHASES_COUNT
+};
+
+static const char *phase_names[PHASES_COUNT] = { "lex", "parse", "sema", "codegen", "opt", "emit" };
+
+/**
+ * @brief Structure of benchmark scenario
+ */
+struct Scenario {
+    std::string name;                           /**< Name of scenario */
+    GeneratorConfig base;                       /**< Program parameters at scale 1 */
+    uint32_t GeneratorConfig::*scaled;          /**< Parameter which is multiplied by scale */
+    bool frontend_only;                         /**< Flag 'measure only lexer and parser' */
+};
+
+/**
+ * @brief Structure of measured phase times
+ */
+struct Measurement {
+    size_t tokens = 0;                          /**< Count of tokens */
+    double seconds[PHASES_COUNT] = {};          /**< Best time of every phase */
+};
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Function for getting seconds since passed time point
+ *
+ * @param start Time point
+ *
+ * @return Seconds
+ */
+static double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Function for compiling program once and measuring every phase
+ *
+ * @param source Source code
+ * @param frontend_only Flag 'measure only lexer and parser'
+ * @param target_machine Target machine for optimization and emission
+ * @param level Optimization level
+ * @param measurement Measured times (only the best times are kept)
+ */
+static void measure(const std::string& source, bool frontend_only, llvm::TargetMachine *target_machine, OptLevel level, Measurement& measurement) {
+    double times[PHASES_COUNT] = {};
+
+    SourceManager sources;
+    uint16_t file_id;
+    sources.add_file("bench.tp", source, file_id);
+
+    Clock::time_point start = Clock::now();
+    Lexer lexer(sources, file_id);
+    std::vector<Token> tokens = lexer.tokenize();
+    times[PHASE_LEX] = seconds_since(start);
+    measurement.tokens = tokens.size();
+
+    start = Clock::now();
+    ASTContext ast_context;
+    Parser parser(std::move(tokens), lexer, sources, ast_context);
+    std::vector<AST::StmtPtr> stmts = parser.parse();
+    times[PHASE_PARSE] = seconds_since(start);
+
+    if (!frontend_only) {
+        start = Clock::now();
+        SemanticAnalyzer semantic(stmts, "bench.tp");
+        semantic.analyze();
+        times[PHASE_SEMANTIC] = seconds_since(start);
+
+        start = Clock::now();
+        CodeGenerator codegen(stmts, "bench.tp");
+        codegen.generate();
+        std::unique_ptr<llvm::Module> module = codegen.get_module();
+        times[PHASE_CODEGEN] = seconds_since(start);
+
+        module->setTargetTriple(target_machine->getTargetTriple());
+        module->setDataLayout(target_machine->createDataLayout());
+        start = Clock::now();
+        Optimizer optimizer(target_machine, level);
+        optimizer.optimize(*module);
+        times[PHASE_OPTIMIZE] = seconds_since(start);
+
+        start = Clock::now();
+        llvm::SmallVector<char, 0> object;
+        llvm::raw_svector_ostream dest(object);
+        llvm::legacy::PassManager pass;
+        auto fileType = static_cast<llvm::CodeGenFileType>(1); // 1 = Object file
+        if (target_machine->addPassesToEmitFile(pass, dest, nullptr, fileType)) {
+            std::cerr << "\033[31mBenchmark error: TargetMachine can't emit a file of this type\033[0m\n";
+            exit(1);
+        }
+        pass.run(*module);
+        times[PHASE_EMIT] = seconds_since(start);
+    }
+
+    for (int i = 0; i < PHASES_COUNT; i++) {
+        if (measurement.seconds[i] == 0 || times[i] < measurement.seconds[i]) {
+            measurement.seconds[i] = times[i];
+        }
+    }
+}
+
+/**
+ * @brief Function for parsing comma separated list of scales
+ *
+ * @param list List of scales
+ * @param scales Parsed scales
+ *
+ * @return 'true' if list is valid and 'false' otherwise
+ */
+static bool parse_scales(const char *list, std::vector<uint32_t>& scales) {
+    scales.clear();
+    while (*list) {
+        char *end;
+        long scale = std::strtol(list, &end, 10);
+        if (end == list || scale <= 0) {
+            return false;
+        }
+        scales.push_back(scale);
+        list = *end == ',' ? end + 1 : end;
+    }
+    return !scales.empty();
+}
+
+int main(int argc, const char *argv[]) {
+    GeneratorConfig custom;
+    bool has_custom = false;
+    std::vector<uint32_t> scales = { 1, 2, 4, 8 };
+    uint32_t iterations = 3;
+    OptLevel level = OPT_O0;
+    std::string write_path;
+
+    for (int i = 1; i < argc; i++) {
+        struct { const char *name; uint32_t *value; } params[] = {
+            { "--functions=", &custom.functions },
+            { "--depth=", &custom.expr_depth },
+            { "--else-if=", &custom.else_if_chain },
+            { "--globals=", &custom.globals },
+            { "--strings=", &custom.strings },
+            { "--string-length=", &custom.string_length },
+            { "--iterations=", &iterations }
+        };
+        bool parsed = false;
+        for (auto& param : params) {
+            size_t len = strlen(param.name);
+            if (strncmp(argv[i], param.name, len) == 0) {
+                *param.value = std::atoi(argv[i] + len);
+                has_custom |= param.value != &iterations;
+                parsed = true;
+            }
+        }
+        if (parsed) {
+            continue;
+        }
+        if (strncmp(argv[i], "--scales=", 9) == 0) {
+            if (!parse_scales(argv[i] + 9, scales)) {
+                std::cerr << "\033[31mBenchmark error: Invalid scales \033[0m'" << argv[i] + 9 << "'\n";
+                return 1;
+            }
+        }
+        else if (strncmp(argv[i], "--write=", 8) == 0) {
+            write_path = argv[i] + 8;
+        }
+        else if (!parse_opt_level(argv[i], level)) {
+            std::cerr << "\033[33mUsage: topazc_bench [--functions=N] [--depth=N] [--else-if=N] [--globals=N] [--strings=N] [--string-length=N]"
+                      << " [--scales=1,2,4,8] [--iterations=N] [-O<level>] [--write=path/to/program.tp]\033[0m\n";
+            return 1;
+        }
+    }
+
+    if (!write_path.empty()) {
+        std::ofstream file(write_path);
+        file << generate_program(custom);
+        if (!file) {
+            std::cerr << "\033[31mBenchmark error: Failed to write \033[0m'" << write_path << "'\n";
+            return 1;
+        }
+        return 0;
+    }
+
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+    TargetConfig target_config;
+    resolve_target_config(target_config);
+    std::string error;
+    std::unique_ptr<llvm::TargetMachine> target_machine = create_target_machine(target_config, level, error);
+    if (!target_machine) {
+        std::cerr << "\033[31mBenchmark error: " << error << "\033[0m\n";
+        return 1;
+    }
+
+    std::vector<Scenario> scenarios;
+    if (has_custom) {
+        scenarios.push_back({ "custom", custom, &GeneratorConfig::functions, custom.strings != 0 });
+    }
+    else {
+        GeneratorConfig functions;
+        functions.functions = 250;
+        GeneratorConfig nesting;
+        nesting.functions = 16;
+        nesting.expr_depth = 32;
+        GeneratorConfig else_if;
+        else_if.functions = 16;
+        else_if.else_if_chain = 64;
+        GeneratorConfig globals;
+        globals.functions = 1;
+        globals.globals = 1000;
+        GeneratorConfig strings;
+        strings.functions = 1;
+        strings.strings = 1000;
+        scenarios.push_back({ "functions", functions, &GeneratorConfig::functions, false });
+        scenarios.push_back({ "nesting", nesting, &GeneratorConfig::expr_depth, false });
+        scenarios.push_back({ "else-if", else_if, &GeneratorConfig::else_if_chain, false });
+        scenarios.push_back({ "globals", globals, &GeneratorConfig::globals, false });
+        scenarios.push_back({ "strings", strings, &GeneratorConfig::strings, true });
+    }
+
+    printf("%-10s %6s %9s %7s", "scenario", "scale", "tokens", "funcs");
+    for (const char *name : phase_names) {
+        printf(" %9s", (std::string(name) + " ms").c_str());
+    }
+    printf(" %9s %12s %10s %10s\n", "total ms", "tokens/s", "funcs/s", "ns/token");
+
+    for (Scenario& scenario : scenarios) {
+        for (uint32_t scale : scales) {
+            GeneratorConfig config = scenario.base;
+            config.*scenario.scaled *= scale;
+            std::string source = generate_program(config);
+
+            Measurement measurement;
+            for (uint32_t i = 0; i < std::max(iterations, 1u); i++) {
+                measure(source, scenario.frontend_only, target_machine.get(), level, measurement);
+            }
+
+            double total = 0;
+            uint32_t functions = config.functions + 1;
+            printf("%-10s %6u %9zu %7u", scenario.name.c_str(), scale, measurement.tokens, functions);
+            for (double seconds : measurement.seconds) {
+                printf(" %9.3f", seconds * 1e3);
+                total += seconds;
+            }
+            printf(" %9.3f %12.0f %10.0f %10.1f\n", total * 1e3, measurement.tokens / total, functions / total, total * 1e9 / measurement.tokens);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file generator.cpp
+ *
+ * @brief generator.hpp implementation
+ */
+
+#include "generator.hpp"
+#include <sstream>
+
+/**
+ * @brief Function for generating nested expression
+ *
+ * @param ss Output stream
+ * @param depth Nesting depth
+ * @param leaf Innermost operand
+ */
+static void generate_expr(std::stringstream& ss, uint32_t depth, const std::string& leaf) {
+    if (depth == 0) {
+        ss << leaf;
+        return;
+    }
+    ss << '(';
+    generate_expr(ss, depth - 1, leaf);
+    ss << (depth % 2 == 0 ? " + " : " - ") << depth << ')';
+}
+
+std::string generate_program(const GeneratorConfig& config) {
+    std::stringstream ss;
+    for (uint32_t i = 0; i < config.globals; i++) {
+        ss << "let int: g_" << i << " = " << i << ";\n";
+    }
+    for (uint32_t i = 0; i < config.strings; i++) {
+        ss << "let int: s_" << i << " = \"";
+        for (uint32_t j = 0; j < config.string_length; j++) {
+            ss << static_cast<char>('a' + (i + j) % 26);
+        }
+        ss << "\";\n";
+    }
+    if (config.globals != 0 || config.strings != 0) {
+        ss << '\n';
+    }
+
+    for (uint32_t i = 0; i < config.functions; i++) {
+        std::string a = "a_" + std::to_string(i);
+        std::string b = "b_" + std::to_string(i);
+        std::string v = "v_" + std::to_string(i);
+        std::string leaf = a + " + " + b;
+        if (config.globals != 0) {
+            leaf += " + g_" + std::to_string(i % config.globals);
+        }
+
+        ss << "fun f_" << i << "(" << a << ": int, " << b << ": int) -> int {\n";
+        ss << "    let int: " << v << " = ";
+        generate_expr(ss, config.expr_depth, leaf);
+        ss << ";\n";
+        for (uint32_t j = 0; j <= config.else_if_chain; j++) {
+            ss << (j == 0 ? "    if " : "    else if ") << a << " == " << j << " {\n";
+            ss << "        " << v << " = " << v << " + " << j + 1 << ";\n";
+            ss << "    }\n";
+        }
+        ss << "    else {\n";
+        ss << "        " << v << " = " << b << ";\n";
+        ss << "    }\n";
+        ss << "    return " << v << ";\n";
+        ss << "}\n\n";
+    }
+
+    ss << "fun main() -> int {\n";
+    ss << "    return 0;\n";
+    ss << "}\n";
+    return ss.str();
+}
@@ -0,0 +1,34 @@
+/**
+ * @file generator.hpp
+ *
+ * @brief Header file for defining the generator of synthetic Topaz programs for benchmarks
+ */
+
+#pragma once
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Structure of generated program parameters
+ */
+struct GeneratorConfig {
+    uint32_t functions = 100;                   /**< Count of generated functions (without 'main') */
+    uint32_t expr_depth = 4;                    /**< Nesting depth of the expression in every function */
+    uint32_t else_if_chain = 4;                 /**< Count of 'else if' branches in every function */
+    uint32_t globals = 16;                      /**< Count of global variables */
+    uint32_t strings = 0;                       /**< Count of global string literals (program is valid only for lexer and parser) */
+    uint32_t string_length = 256;               /**< Length of every string literal */
+};
+
+/**
+ * @brief Function for generating Topaz program
+ *
+ * Every name in generated program is unique (arguments and locals too), and functions are never called, so the program is accepted
+ * by the semantic analyzer of current compiler version. Programs with string literals are not accepted by the semantic analyzer
+ * (Topaz does not have string type yet), so they are only for lexer and parser benchmarks
+ *
+ * @param config Parameters of program
+ *
+ * @return Source code of program
+ */
+std::string generate_program(const GeneratorConfig& config);
@@ -0,0 +1,140 @@
+/**
+ * @file cache.hpp
+ *
+ * @brief Header file for defining the content-addressed compilation cache
+ */
+
+#pragma once
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/ADT/StringRef.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Flags of cached entry (stored in the first byte of entry, before object)
+ */
+enum CacheEntryFlags : uint8_t {
+    CACHE_ENTRY_HAS_MAIN = 1,                   /**< Module has entry point 'main' */
+    CACHE_ENTRY_PARTITIONED = 2                 /**< Entry contains several size-prefixed objects (one per code generation partition) */
+};
+
+constexpr size_t CACHE_ENTRY_HEADER_SIZE = 17;  /**< Size of entry header (flags, 64-bit payload size and 64-bit xxHash64 of payload) */
+
+/**
+ * @brief Base class of cache backend
+ *
+ * Backend stores compiled objects by key (hex digest of everything that affects the object). Backend errors are never fatal:
+ * failed lookup is a miss and failed store is ignored
+ */
+class CacheBackend {
+public:
+    virtual ~CacheBackend() = default;
+
+    /**
+     * @brief Method for looking up cached entry
+     *
+     * @param key Cache key
+     *
+     * @return Cached entry or nullptr in case of miss
+     */
+    virtual std::unique_ptr<llvm::MemoryBuffer> lookup(const std::string& key) = 0;
+
+    /**
+     * @brief Method for storing entry
+     *
+     * @param key Cache key
+     * @param data Entry data
+     */
+    virtual void store(const std::string& key, llvm::StringRef data) = 0;
+};
+
+/**
+ * @brief Cache backend in local directory
+ *
+ * Every entry is a file named by key. Entries are written into temporary file and renamed, so concurrent compilers never see partial entries
+ */
+class LocalCacheBackend : public CacheBackend {
+private:
+    std::string dir;                                                            /**< Path to the cache directory */
+
+public:
+    LocalCacheBackend(std::string d) : dir(d) {}
+    ~LocalCacheBackend() override = default;
+
+    std::unique_ptr<llvm::MemoryBuffer> lookup(const std::string& key) override;
+    void store(const std::string& key, llvm::StringRef data) override;
+};
+
+/**
+ * @brief Cache backend on HTTP server
+ *
+ * Protocol: 'GET <prefix>/<key>' returns 200 with entry in body or 404 in case of miss; 'PUT <prefix>/<key>' with entry in body stores it.
+ * Any directory-serving HTTP server with PUT support (or a small local stand-in server) can be used
+ */
+class HttpCacheBackend : public CacheBackend {
+private:
+    std::string host;                                                           /**< Server host */
+    uint16_t port;                                                              /**< Server port */
+    std::string prefix;                                                         /**< Path prefix of entries on server */
+
+public:
+    HttpCacheBackend(std::string h, uint16_t p, std::string pr) : host(h), port(p), prefix(pr) {}
+    ~HttpCacheBackend() override = default;
+
+    std::unique_ptr<llvm::MemoryBuffer> lookup(const std::string& key) override;
+    void store(const std::string& key, llvm::StringRef data) override;
+
+private:
+    /**
+     * @brief Method for sending HTTP request to the server
+     *
+     * @param method HTTP method
+     * @param key Cache key
+     * @param body Request body
+     * @param response_body Response body
+     *
+     * @return HTTP status code or -1 in case of network error
+     */
+    int request(const std::string& method, const std::string& key, llvm::StringRef body, std::string& response_body);
+};
+
+/**
+ * @brief Function for creating cache backend by spec
+ *
+ * Spec is 'http://<host>[:<port>][/<prefix>]' for HTTP backend and path to the directory for local backend
+ *
+ * @param spec Cache spec
+ * @param error Error message in case of fail
+ *
+ * @return Cache backend or nullptr in case of fail
+ */
+std::unique_ptr<CacheBackend> create_cache_backend(const std::string& spec, std::string& error);
+
+/**
+ * @brief Function for packing objects into cache entry
+ *
+ * Entry starts with flags byte, 64-bit little-endian size and xxHash64 of payload, so truncated or damaged entry is detected.
+ * Payload of single object is the object as is. Several objects are stored as 64-bit little-endian size and bytes of every object
+ * with 'CACHE_ENTRY_PARTITIONED' flag
+ *
+ * @param flags Entry flags
+ * @param objects Object files
+ *
+ * @return Cache entry
+ */
+std::string pack_cache_entry(uint8_t flags, llvm::ArrayRef<llvm::StringRef> objects);
+
+/**
+ * @brief Function for unpacking objects from cache entry
+ *
+ * @param entry Cache entry
+ * @param flags Entry flags
+ * @param objects Object files (views into the entry)
+ *
+ * @return 'true' if entry is well-formed and its payload matches size and hash from header, 'false' otherwise
+ */
+bool unpack_cache_entry(llvm::StringRef entry, uint8_t& flags, std::vector<llvm::StringRef>& objects);
@@ -7,13 +7,17 @@
 #pragma once
 #include "../parser/ast.hpp"
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/IR/DebugInfoMetadata.h>
 #include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/DIBuilder.h>
 #include <llvm/IR/BasicBlock.h>
 #include <llvm/IR/IRBuilder.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
 #include <llvm/IR/Type.h>
+#include <functional>
+#include <string>
 #include <stack>
 #include <map>
 
@@ -24,14 +28,19 @@ class CodeGenerator {
 private:
     std::string file_name;                                                      /**< Absolute path to the Topaz source code */
     std::vector<AST::StmtPtr>& stmts;                                           /**< AST Tree (statements from Parser) */
-    llvm::LLVMContext context;                                                  /**< LLVM Context */
+    std::unique_ptr<llvm::LLVMContext> context;                                 /**< LLVM Context (owned until it is taken with the module) */
     llvm::IRBuilder<> builder;                                                  /**< LLVM IR Builder */
     std::unique_ptr<llvm::Module> module;                                       /**< LLVM Module (module name is relative path to the Topaz source code) */
-    std::stack<std::map<std::string, llvm::Value*>> variables;                  /**< View scope of the variables table */
-    std::map<std::string, llvm::Function*> functions;                           /**< Functions table */
+    std::stack<std::map<std::string, llvm::Value*, std::less<>>> variables;     /**< View scope of the variables table */
+    std::map<std::string, llvm::Function*, std::less<>> functions;              /**< Functions table */
+    bool debug_info;                                                            /**< Flag 'emit line tables' */
+    bool optimized;                                                             /**< Flag 'code will be optimized' (for debug info) */
+    std::unique_ptr<llvm::DIBuilder> di_builder;                                /**< Debug info builder (nullptr if debug info is disabled) */
+    llvm::DIFile *di_file = nullptr;                                            /**< Debug info of the source file */
+    llvm::DISubprogram *di_subprogram = nullptr;                                /**< Debug info of the current function (nullptr outside functions) */
 
 public:
-    CodeGenerator(std::vector<AST::StmtPtr>& s, std::string fn) : context(), builder(context), module(std::make_unique<llvm::Module>(fn, context)), stmts(s), file_name(fn) {
+    CodeGenerator(std::vector<AST::StmtPtr>& s, std::string fn, bool dbg = false, bool opt = false) : context(std::make_unique<llvm::LLVMContext>()), builder(*context), module(std::make_unique<llvm::Module>(fn, *context)), stmts(s), file_name(fn), debug_info(dbg), optimized(opt) {
         variables.push({});
     }
 
@@ -45,10 +54,12 @@ public:
     /**
      * @brief Method for printing generated LLVM IR code
      *
-     * This method printing generated LLVM IR code into llvm::outs(). This method needs the entry point 'main'
+     * This method printing generated LLVM IR code into passed stream (llvm::outs() by default). This method needs the entry point 'main'
+     *
+     * @param os Output stream
      */
-    void print_ir() {
-        module->print(llvm::outs(), nullptr);
+    void print_ir(llvm::raw_ostream& os = llvm::outs()) {
+        module->print(os, nullptr);
     }
 
     /**
@@ -62,7 +73,36 @@ public:
         return std::move(module);
     }
 
+    /**
+     * @brief Method for getting LLVM Context of the module
+     *
+     * This method passes ownership of the LLVM Context to the caller (for example, to wrap the module into llvm::orc::ThreadSafeModule).
+     * After this call code generator must not generate code anymore
+     *
+     * @return LLVM Context of the module
+     */
+    std::unique_ptr<llvm::LLVMContext> get_context() {
+        return std::move(context);
+    }
+
 private:
+    /**
+     * @brief Method for creating compile unit of debug info
+     *
+     * This method creates line-tables-only compile unit with 'debug info for profiling' (discriminators), which is enough for
+     * mapping sample profiles to functions and lines, and adds debug info module flags
+     */
+    void create_debug_info();
+
+    /**
+     * @brief Method for setting debug location of generated instructions
+     *
+     * This method does nothing if debug info is disabled or generator is outside of function
+     *
+     * @param line Line coordinate
+     */
+    void set_debug_location(uint32_t line);
+
     /**
      * @brief Method for generating LLVM IR code for passing statement
      *
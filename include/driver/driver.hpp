@@ -0,0 +1,195 @@
+/**
+ * @file driver.hpp
+ *
+ * @brief Header file for defining the compiler driver
+ */
+
+#pragma once
+#include "../optimizer/optimizer.hpp"
+#include "../cache/cache.hpp"
+#include "../linker/linker.hpp"
+#include "../target/target.hpp"
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/ADT/SmallVector.h>
+#include <llvm/ADT/ArrayRef.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Structure of compiler options
+ */
+struct CompilerOptions {
+    std::vector<std::string> sources;           /**< Paths to the Topaz source files */
+    std::string output_path;                    /**< Path to the output executable (empty for the path of the first source without extension) */
+    bool print_tokens = false;                  /**< Flag 'print tokens' */
+    bool print_ir = false;                      /**< Flag 'print LLVM IR' */
+    bool output_is_object = false;              /**< Flag 'stop after emitting object files' */
+    OptLevel opt_level = OPT_O0;                /**< Optimization level */
+    LinkerKind linker_kind = LINKER_EXTERNAL;   /**< Kind of linker */
+    TargetConfig target_config;                 /**< Target of compilation */
+    uint32_t jobs = 1;                          /**< Count of source files compiled in parallel */
+    uint32_t codegen_threads = 1;               /**< Count of partitions of one module optimized and emitted in parallel */
+    bool thin_lto = false;                      /**< Flag 'emit ThinLTO bitcode and run ThinLTO backend at link time' */
+    ProfileOptions profile;                     /**< Profile-guided optimization options */
+    std::string cache;                          /**< Compilation cache spec (directory or 'http://' URL, empty for disabled cache) */
+    bool run = false;                           /**< Flag 'run program with JIT instead of building executable' */
+    std::vector<std::string> run_args;          /**< Arguments of the program run with JIT */
+    bool time_trace = false;                    /**< Flag 'write Chrome trace of compilation time' */
+    std::string time_trace_path;                /**< Path to the time trace file (empty for the executable path with '.time-trace' extension) */
+    uint32_t time_trace_granularity = 500;      /**< Minimum duration of traced event in microseconds */
+    bool mem_report = false;                    /**< Flag 'print memory usage after every phase and sizes of compiler structures' */
+    std::string server_socket;                  /**< Path to the Unix socket for running compile server (empty for usual compilation) */
+    std::string connect_socket;                 /**< Path to the Unix socket of compile server for sending compilation to (empty for local compilation) */
+};
+
+/**
+ * @brief Function for parsing command line options
+ *
+ * This function parsing command line options into passed options structure. If option is invalid, then the error is printed
+ *
+ * @param argc Count of arguments
+ * @param argv Arguments
+ * @param options Parsed options
+ *
+ * @return 'true' if options are valid and 'false' otherwise
+ */
+bool parse_options(int argc, const char *argv[], CompilerOptions& options);
+
+/**
+ * @brief Compiler driver class
+ *
+ * Runs lexer, parser, semantic analyzer, code generator, optimizer and object emission for every source file
+ * (in parallel if more than one job is allowed) and links all objects into one executable
+ */
+class Driver {
+private:
+    CompilerOptions options;                                                    /**< Compiler options */
+    std::unique_ptr<CacheBackend> cache;                                        /**< Compilation cache (nullptr if cache is disabled) */
+    std::string compiler_id;                                                    /**< Identity of the compiler build (part of cache keys) */
+    std::string profile_id;                                                     /**< Hash of used profile (part of cache keys) */
+
+    /**
+     * @brief Structure of result of compilation of one source file
+     */
+    struct CompileResult {
+        bool success = false;                                                   /**< Flag 'compilation is success' */
+        bool has_main = false;                                                  /**< Flag 'module has entry point main' */
+        std::string object_path;                                                /**< Path to the object file (objects of other partitions get '.part<N>' suffix) */
+        std::vector<std::string> object_paths;                                  /**< Paths to the written object files */
+        std::vector<std::unique_ptr<llvm::MemoryBuffer>> objects;               /**< Object files (if they are emitted into memory) */
+        std::unique_ptr<llvm::LLVMContext> context;                             /**< LLVM Context of the module (JIT mode only) */
+        std::unique_ptr<llvm::Module> module;                                   /**< Optimized module (JIT mode only, nullptr if object is taken from cache) */
+        std::string cache_key;                                                  /**< Cache key of the source file (empty if cache is disabled) */
+        std::string output;                                                     /**< Printed tokens and LLVM IR */
+        std::string diagnostics;                                                /**< Printed errors of compilation */
+        std::string error;                                                      /**< Error message in case of fail */
+    };
+
+public:
+    Driver(CompilerOptions o) : options(o) {}
+
+    /**
+     * @brief Method for running the compiler
+     *
+     * @return Exit code of the compiler
+     */
+    int run();
+
+private:
+    /**
+     * @brief Method for compiling all sources and linking (or running) the program
+     *
+     * @return Exit code of the compiler
+     */
+    int build();
+
+    /**
+     * @brief Method for compiling one source file into object
+     *
+     * This method running all compilation phases for passed source file. Each call uses its own LLVM context and target machine,
+     * so this method can be called from several threads at once. In JIT mode this method stops after optimization and returns the module
+     * (or cached object) instead of emitting object
+     *
+     * @param source_path Path to the Topaz source file
+     * @param object_path Path to the output object file
+     * @param emit_to_memory Flag 'emit object into memory instead of file'
+     *
+     * @return Result of compilation
+     */
+    CompileResult compile_file(const std::string& source_path, const std::string& object_path, bool emit_to_memory);
+
+    /**
+     * @brief Method for optimizing and emitting module split into partitions in parallel
+     *
+     * Module is split by functions with llvm::SplitModule. Every partition is moved into its own LLVM context through bitcode,
+     * so partitions are optimized and emitted concurrently on the thread pool. Partitions are optimized after splitting, so functions are
+     * never inlined across partitions. Pool uses only the share of hardware threads of one of the sources compiled in parallel ('-j').
+     * Objects of all partitions are linked together
+     *
+     * @param module Module (it is modified by splitting)
+     * @param count Count of partitions
+     * @param objects Emitted object files
+     * @param error Error message in case of fail
+     *
+     * @return 'true' if all partitions are emitted and 'false' otherwise
+     */
+    bool emit_partitions(llvm::Module& module, uint32_t count, std::vector<llvm::SmallVector<char, 0>>& objects, std::string& error);
+
+    /**
+     * @brief Method for optimizing and emitting one partition of module
+     *
+     * @param bitcode Bitcode of the partition
+     * @param object Emitted object file
+     * @param error Error message in case of fail
+     *
+     * @return 'true' if partition is emitted and 'false' otherwise
+     */
+    bool emit_partition(llvm::StringRef bitcode, llvm::SmallVector<char, 0>& object, std::string& error);
+
+    /**
+     * @brief Method for running compiled program with JIT
+     *
+     * @param results Results of compilation of all source files
+     *
+     * @return Exit code of the program
+     */
+    int run_jit(std::vector<CompileResult>& results);
+
+    /**
+     * @brief Method for computing cache key of source file
+     *
+     * Key is SHA-256 of the source bytes and absolute path, compiler identity, target triple, CPU, features and all options which affect the object file
+     *
+     * @param source_path Absolute path to the source file
+     * @param source Source code
+     *
+     * @return Hex digest as cache key
+     */
+    std::string get_cache_key(llvm::StringRef source_path, llvm::StringRef source);
+
+    /**
+     * @brief Method for writing emitted objects into result
+     *
+     * This method keeps the objects in memory or writes them into object files of result
+     *
+     * @param result Result of compilation
+     * @param objects Object files contents (one per code generation partition)
+     * @param emit_to_memory Flag 'keep objects in memory instead of files'
+     *
+     * @return 'true' if objects are written and 'false' otherwise
+     */
+    bool write_objects(CompileResult& result, llvm::ArrayRef<llvm::StringRef> objects, bool emit_to_memory);
+
+    /**
+     * @brief Method for getting path without extension
+     *
+     * @param path Path to the file
+     *
+     * @return Path without extension
+     */
+    static std::string remove_extension(std::string path);
+};
@@ -1,12 +1,15 @@
 /**
  * @file exception.hpp
  *
- * @brief Header file for defining thrown exceptions by the compiler
+ * @brief Header file for defining thrown exceptions and diagnostics of the compiler
  */
 
 #pragma once
+#include <exception>
 #include <cstdint>
+#include <ostream>
 #include <string>
+#include <vector>
 
 /**
  * @brief Subsystem from which the exception throwed
@@ -18,14 +21,121 @@ enum SubsystemType {
     SUB_CODEGEN                                 /**< Code generator subsystem */
 };
 
+/**
+ * @brief Structure of compilation error
+ */
+struct Diagnostic {
+    SubsystemType subsystem;                    /**< Subsystem which reported the error */
+    std::string msg;                            /**< Error message */
+    uint32_t line;                              /**< Line of the error */
+    std::string file_name;                      /**< File of the error */
+};
+
+/**
+ * @brief Exception thrown by throw_exception for unwinding to the nearest recovery point
+ *
+ * Error is already recorded in the diagnostics engine when exception is thrown. Fatal exception (limit of errors is reached)
+ * must not be recovered: the whole compilation of the file is stopped
+ */
+class CompilationError : public std::exception {
+private:
+    bool fatal;                                 /**< Flag 'stop compilation of the file instead of recovery' */
+
+public:
+    CompilationError(bool f) : fatal(f) {}
+
+    const char *what() const noexcept override {
+        return "compilation error";
+    }
+
+    /**
+     * @brief Method for checking that compilation must be stopped
+     *
+     * @return 'true' if error is fatal and 'false' otherwise
+     */
+    bool is_fatal() const {
+        return fatal;
+    }
+};
+
+/**
+ * @brief Diagnostics engine class
+ *
+ * Collects errors of compilation of one file, so subsystems can recover after error and all errors are reported in batch.
+ * Engine is installed for the thread which created it (until destruction), so files compiled in parallel have separate engines
+ */
+class DiagnosticEngine {
+private:
+    std::vector<Diagnostic> diagnostics;        /**< Collected errors */
+    uint32_t error_limit;                       /**< Count of errors after which compilation is stopped */
+    DiagnosticEngine *previous;                 /**< Engine installed for the thread before this one */
+
+public:
+    DiagnosticEngine(uint32_t limit = 20);
+    ~DiagnosticEngine();
+
+    DiagnosticEngine(const DiagnosticEngine&) = delete;
+    DiagnosticEngine& operator=(const DiagnosticEngine&) = delete;
+
+    /**
+     * @brief Method for recording error
+     *
+     * @param diagnostic Error
+     *
+     * @return 'true' if limit of errors is reached and 'false' otherwise
+     */
+    bool report(Diagnostic diagnostic);
+
+    /**
+     * @brief Method for checking that at least one error is recorded
+     *
+     * @return 'true' if engine has errors and 'false' otherwise
+     */
+    bool has_errors() const {
+        return !diagnostics.empty();
+    }
+
+    /**
+     * @brief Method for getting count of recorded errors
+     *
+     * @return Count of errors
+     */
+    size_t get_errors_count() const {
+        return diagnostics.size();
+    }
+
+    /**
+     * @brief Method for printing all recorded errors
+     *
+     * @param os Output stream
+     */
+    void print(std::ostream& os) const;
+
+    /**
+     * @brief Method for getting engine installed for the current thread
+     *
+     * @return Diagnostics engine or nullptr if no engine is installed
+     */
+    static DiagnosticEngine *get_current();
+};
+
+/**
+ * @brief Function for printing one error
+ *
+ * @param os Output stream
+ * @param diagnostic Error
+ */
+void print_diagnostic(std::ostream& os, const Diagnostic& diagnostic);
+
 /**
  * @brief Function for throwing exception
  *
- * This function throwing exception based passed arguments
+ * This function records error in the diagnostics engine of the current thread (or prints it if no engine is installed)
+ * and throws CompilationError for unwinding to the nearest recovery point
  *
  * @param type Subsystem from which the exception throwned
  * @param msg Exception message
  * @param line Line where exception throwed
  * @param file_name File where exception throwed
  */
-void throw_exception(SubsystemType type, std::string msg, uint32_t line, std::string file_name);
\ No newline at end of file
+[[noreturn]] void throw_exception(SubsystemType type, std::string msg, uint32_t line, std::string file_name);
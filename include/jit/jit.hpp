@@ -0,0 +1,105 @@
+/**
+ * @file jit.hpp
+ *
+ * @brief Header file for defining JIT execution of Topaz programs
+ */
+
+#pragma once
+#include "../optimizer/optimizer.hpp"
+#include "../target/target.hpp"
+#include "../cache/cache.hpp"
+#include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/ExecutionEngine/ObjectCache.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include <mutex>
+#include <map>
+
+/**
+ * @brief Object cache of JIT
+ *
+ * Stores objects compiled by JIT into cache backend in the same entry format as the driver. Cache lookup is done by the driver before
+ * running the frontend (so a hit skips lexing too), that's why getObject always misses
+ */
+class JITObjectCache : public llvm::ObjectCache {
+private:
+    CacheBackend *backend;                                                      /**< Cache backend */
+    std::mutex keys_mutex;                                                      /**< Mutex of keys table */
+    std::map<std::string, std::string> keys;                                    /**< Cache keys of modules (by module identifier) */
+
+public:
+    JITObjectCache(CacheBackend *b) : backend(b) {}
+
+    /**
+     * @brief Method for setting cache key of module
+     *
+     * @param module_id Module identifier
+     * @param key Cache key
+     */
+    void add_key(const std::string& module_id, const std::string& key);
+
+    void notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef object) override;
+    std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module *module) override;
+};
+
+/**
+ * @brief JIT class
+ *
+ * Compiles modules and cached objects with ORC LLJIT inside the compiler process and calls the entry point 'main'.
+ * Symbols of the compiler process (libc) are visible for JIT-compiled code
+ */
+class JIT {
+private:
+    std::unique_ptr<JITObjectCache> object_cache;                               /**< Object cache (nullptr if cache is disabled) */
+    std::unique_ptr<llvm::orc::LLJIT> jit;                                      /**< ORC LLJIT instance */
+
+public:
+    /**
+     * @brief Method for initializing JIT
+     *
+     * @param config Target of compilation (must be the host)
+     * @param level Optimization level of code generation
+     * @param cache Cache backend for compiled objects (nullptr for disabled cache)
+     * @param error Error message in case of fail
+     *
+     * @return 'true' if JIT is initialized and 'false' otherwise
+     */
+    bool init(const TargetConfig& config, OptLevel level, CacheBackend *cache, std::string& error);
+
+    /**
+     * @brief Method for adding module into JIT
+     *
+     * @param module LLVM Module
+     * @param context LLVM Context of the module
+     * @param cache_key Cache key of the module (empty if the object should not be cached)
+     * @param error Error message in case of fail
+     *
+     * @return 'true' if module is added and 'false' otherwise
+     */
+    bool add_module(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context, const std::string& cache_key, std::string& error);
+
+    /**
+     * @brief Method for adding compiled object into JIT
+     *
+     * @param object Object file
+     * @param error Error message in case of fail
+     *
+     * @return 'true' if object is added and 'false' otherwise
+     */
+    bool add_object(std::unique_ptr<llvm::MemoryBuffer> object, std::string& error);
+
+    /**
+     * @brief Method for running the entry point 'main'
+     *
+     * @param program_name Name of the program (argv[0])
+     * @param args Arguments of the program
+     * @param exit_code Value returned from 'main'
+     * @param error Error message in case of fail
+     *
+     * @return 'true' if 'main' is called and 'false' otherwise
+     */
+    bool run_main(const std::string& program_name, const std::vector<std::string>& args, int& exit_code, std::string& error);
+};
@@ -5,58 +5,114 @@
  */
 
 #pragma once
+#include "../source/source.hpp"
 #include "token.hpp"
+#include <cstddef>
+#include <string_view>
 #include <vector>
-#include <map>
 
 /**
  * @brief Lexer class
  */
 class Lexer {
+public:
+    static constexpr size_t PARALLEL_THRESHOLD = 1 << 20;       /**< Minimum size of source which is tokenized in parallel */
+    static constexpr size_t MIN_CHUNK_SIZE = 256 << 10;         /**< Minimum size of chunk of source tokenized by one thread */
+
 private:
-    std::string file_name;                                      /**< Name of the file containing the token */
-    std::string source;                                         /**< Source code on Topaz */
+    std::string file_name;                                      /**< Name of the source file (for errors) */
+    uint16_t file_id;                                           /**< ID of the source file in the SourceManager */
+    std::string_view source;                                    /**< Source code on Topaz (view into the buffer owned by caller) */
     size_t source_len;                                          /**< Length of source code (optimization) */
     uint32_t pos;                                               /**< Position index into source code */
     uint32_t line;                                              /**< Line coordinate */
-    uint32_t column;                                            /**< Column coordinate */
-    std::map<std::string, TokenType> keywords {                 /**< Keywords table */
-        {"bool", TOK_BOOL},
-        {"char", TOK_CHAR},
-        {"short", TOK_SHORT},
-        {"int", TOK_INT},
-        {"long", TOK_LONG},
-        {"float", TOK_FLOAT},
-        {"double", TOK_DOUBLE},
-        {"noth", TOK_NOTH},
-        {"let", TOK_LET},
-        {"fun", TOK_FUN},
-        {"if", TOK_IF},
-        {"else", TOK_ELSE},
-        {"for", TOK_FOR},
-        {"while", TOK_WHILE},
-        {"const", TOK_CONST},
-        {"return", TOK_RETURN}
-    };
+    uint32_t line_start;                                        /**< Offset of the first character of current line (column is computed from it) */
+    std::vector<NumberValue> number_values;                     /**< Values of tokenized number literals (indexed by Token::value_index) */
 
 public:
-    Lexer(std::string src, std::string fn) : source(src), source_len(src.length()), pos(0), line(1), column(1), file_name(fn) {}
+    Lexer(const SourceManager& sources, uint16_t fid) : file_name(sources.get_file_name(fid)), file_id(fid), source(sources.get_source(fid)),
+                                                        source_len(source.length()), pos(0), line(1), line_start(0) {}
 
     /**
      * @brief Method for tokenizing source code
      *
      * This method tokenizing source code into vector of tokens and returns it
+     * Invalid tokens are reported into the diagnostics engine and skipped
+     *
+     * Source of at least PARALLEL_THRESHOLD bytes is split into chunks of similar size at newlines (every thread finds borders of own
+     * chunk), chunks are tokenized in parallel and their tokens are concatenated. If any chunk has invalid tokens (including literal
+     * cut by border of chunk), then source is tokenized again sequentially, so diagnostics are the same as without threads
+     *
+     * @param threads Maximum count of threads
      *
      * @return Vector of tokens after tokenizing
      */
-    std::vector<Token> tokenize();
+    std::vector<Token> tokenize(uint32_t threads = 1);
+
+    /**
+     * @brief Method for tokenizing the next token of source code
+     *
+     * This method skipping whitespaces and comments and tokenizing one token (used by TokenStream for tokenizing on demand)
+     * Invalid tokens are reported into the diagnostics engine and skipped
+     *
+     * @param token Tokenized token
+     *
+     * @return 'true' if token is tokenized and 'false' at the end of source code
+     */
+    bool next_token(Token& token);
+
+    /**
+     * @brief Method for resetting lexer to the beginning of source code
+     */
+    void reset();
+
+    /**
+     * @brief Method for getting value of number literal token
+     *
+     * @param token Number literal token tokenized by this lexer
+     *
+     * @return Parsed value of literal
+     */
+    const NumberValue& get_number_value(const Token& token) const {
+        return number_values[token.value_index];
+    }
+
+    /**
+     * @brief Method for clearing the table of values of number literals
+     *
+     * Used by TokenStream, which copies values into its ring buffer, so values of tokens read before are not available after it
+     */
+    void clear_number_values() {
+        number_values.clear();
+    }
 
 private:
+    /**
+     * @brief Constructor of lexer of source chunk
+     *
+     * @param parent Lexer of whole source
+     * @param begin Offset of chunk (it has to be start of line)
+     * @param end End offset of chunk
+     * @param l Line of chunk start
+     */
+    Lexer(const Lexer& parent, uint32_t begin, uint32_t end, uint32_t l) : file_name(parent.file_name), file_id(parent.file_id), source(parent.source),
+                                                                          source_len(end), pos(begin), line(l), line_start(begin) {}
+
+    /**
+     * @brief Method for tokenizing source code split into chunks in parallel
+     *
+     * @param threads Maximum count of threads
+     * @param tokens Vector of tokens after tokenizing
+     *
+     * @return 'true' if all chunks are tokenized without errors and 'false' otherwise
+     */
+    bool tokenize_parallel(uint32_t threads, std::vector<Token>& tokens);
+
     /**
      * @brief Method for tokenizing identifier token
      *
      * This method tokenizing identifier token and returns it
-     * If token value matches a keyword from the table, the keyword token is returned
+     * If token value matches a keyword, the keyword token is returned
      * If token value matches a 'true' or 'false', the boolean literal token is returned
      *
      * @return Token as identifier, keyword or boolean literal
@@ -74,6 +130,17 @@ private:
      */
     Token tokenize_number_lit();
 
+    /**
+     * @brief Method for parsing value of number literal token
+     *
+     * This method parsing digits of literal with std::from_chars and adds value into the table of number values
+     * If value is out of range of literal type, then throwing exception
+     *
+     * @param token Number literal token
+     * @param digits_len Length of literal text without suffix
+     */
+    void parse_number_value(Token& token, uint32_t digits_len);
+
     /**
      * @brief Method for tokenizing string literal
      *
@@ -105,6 +172,22 @@ private:
      */
     Token tokenize_op();
 
+    /**
+     * @brief Method for recovering after invalid token
+     *
+     * This method skipping the rest of invalid token (until whitespace or ';'), so tokenizing continues after the error
+     *
+     */
+    void recover();
+
+    /**
+     * @brief Method for skipping whitespaces
+     *
+     * This method skipping spaces and newlines with vectorized kernel, newlines are counted in bulk
+     *
+     */
+    void skip_whitespaces();
+
     /**
      * @brief Method for skipping comments
      *
@@ -123,6 +206,27 @@ private:
      */
     const char get_escape_sequence();
 
+    /**
+     * @brief Method for creating token which text starts at passed offset and ends at lexer pos
+     *
+     * @param type Token type
+     * @param start Offset of the token text
+     * @param tmp_l Token line
+     * @param tmp_c Token column
+     *
+     * @return Token
+     */
+    Token make_token(TokenType type, uint32_t start, uint32_t tmp_l, uint32_t tmp_c) const;
+
+    /**
+     * @brief Method for getting column of lexer pos
+     *
+     * @return Column coordinate
+     */
+    uint32_t get_column() const {
+        return pos - line_start + 1;
+    }
+
     /**
      * @brief Method for getting character from source code by lexer pos and passed offset
      *
@@ -138,9 +242,27 @@ private:
     /**
      * @brief Method for skipping current character from source code and returns it
      *
-     * This method caching current character from source code, skip it, changing lexer's pos, line and column and return cached character
+     * This method caching current character from source code, skip it, changing lexer's pos, line and line start and return cached character
      *
      * @return Skipped character
      */
     const char advance();
-};
\ No newline at end of file
+};
+
+/**
+ * @brief Function for getting value of string literal
+ *
+ * @param text Token text (with quotes and escape-sequences already checked by lexer)
+ *
+ * @return String with decoded escape-sequences
+ */
+std::string get_string_lit_value(std::string_view text);
+
+/**
+ * @brief Function for getting value of character literal
+ *
+ * @param text Token text (with quotes and escape-sequence already checked by lexer)
+ *
+ * @return Decoded character
+ */
+char get_character_lit_value(std::string_view text);
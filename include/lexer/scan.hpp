@@ -0,0 +1,192 @@
+/**
+ * @file scan.hpp
+ *
+ * @brief Header file for defining the vectorized scanning kernels of the lexer
+ *
+ * Kernels process 32 bytes (AVX2) or 16 bytes (SSE2) at a time and finish the tail with scalar code.
+ * Bodies of kernels are in scan_kernels.inc and are compiled once for every width. On x86 with GCC or Clang the AVX2 copy is
+ * compiled with target attribute, so it does not need -mavx2, and is chosen at runtime when CPU supports AVX2.
+ * Targets without SSE2 use the scalar fallback
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <bit>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define TOPAZ_SCAN_AVX2
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define TOPAZ_SCAN_AVX2
+#define TOPAZ_SCAN_AVX2_DISPATCH
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#define TOPAZ_SCAN_SSE2
+#endif
+
+namespace scan {
+    /**
+     * @brief Function for checking that character continues identifier
+     *
+     * @param c Character
+     *
+     * @return 'true' for latin letters, digits and '_'
+     */
+    inline bool is_id_char(char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+#define TOPAZ_SCAN_SIMD
+#if defined(TOPAZ_SCAN_AVX2)
+#if defined(TOPAZ_SCAN_AVX2_DISPATCH) && defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(TOPAZ_SCAN_AVX2_DISPATCH)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+    namespace avx2 {
+        using Vec = __m256i;                                /**< Vector of bytes */
+        using Mask = uint32_t;                              /**< Mask with one bit per byte of vector */
+        constexpr size_t VEC_SIZE = 32;                     /**< Count of bytes in vector */
+
+        inline Vec load(const char *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+        inline Vec splat(char c) { return _mm256_set1_epi8(c); }
+        inline Vec eq(Vec a, Vec b) { return _mm256_cmpeq_epi8(a, b); }
+        inline Vec gt(Vec a, Vec b) { return _mm256_cmpgt_epi8(a, b); }
+        inline Vec vor(Vec a, Vec b) { return _mm256_or_si256(a, b); }
+        inline Vec vand(Vec a, Vec b) { return _mm256_and_si256(a, b); }
+        inline Mask to_mask(Vec v) { return static_cast<Mask>(_mm256_movemask_epi8(v)); }
+
+#include "scan_kernels.inc"
+    }
+#if defined(TOPAZ_SCAN_AVX2_DISPATCH) && defined(__clang__)
+#pragma clang attribute pop
+#elif defined(TOPAZ_SCAN_AVX2_DISPATCH)
+#pragma GCC pop_options
+#endif
+#endif
+
+#if defined(TOPAZ_SCAN_SSE2)
+    namespace sse2 {
+        using Vec = __m128i;                                /**< Vector of bytes */
+        using Mask = uint32_t;                              /**< Mask with one bit per byte of vector */
+        constexpr size_t VEC_SIZE = 16;                     /**< Count of bytes in vector */
+
+        inline Vec load(const char *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+        inline Vec splat(char c) { return _mm_set1_epi8(c); }
+        inline Vec eq(Vec a, Vec b) { return _mm_cmpeq_epi8(a, b); }
+        inline Vec gt(Vec a, Vec b) { return _mm_cmpgt_epi8(a, b); }
+        inline Vec vor(Vec a, Vec b) { return _mm_or_si128(a, b); }
+        inline Vec vand(Vec a, Vec b) { return _mm_and_si128(a, b); }
+        inline Mask to_mask(Vec v) { return static_cast<Mask>(_mm_movemask_epi8(v)); }
+
+#include "scan_kernels.inc"
+    }
+#endif
+#undef TOPAZ_SCAN_SIMD
+
+#if !defined(TOPAZ_SCAN_SSE2)
+    namespace scalar {
+#include "scan_kernels.inc"
+    }
+#endif
+
+    /**
+     * @brief Function for checking that AVX2 kernels can be used. CPU is queried once
+     *
+     * @return 'true' if AVX2 kernels are compiled and supported by CPU
+     */
+    inline bool use_avx2() {
+#if defined(TOPAZ_SCAN_AVX2_DISPATCH)
+        static const bool supported = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") != 0;
+        }();
+        return supported;
+#elif defined(TOPAZ_SCAN_AVX2)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+#if defined(TOPAZ_SCAN_AVX2)
+#define TOPAZ_SCAN_CALL(name, ...) (use_avx2() ? avx2::name(__VA_ARGS__) : TOPAZ_SCAN_BASE::name(__VA_ARGS__))
+#else
+#define TOPAZ_SCAN_CALL(name, ...) TOPAZ_SCAN_BASE::name(__VA_ARGS__)
+#endif
+#if defined(TOPAZ_SCAN_SSE2)
+#define TOPAZ_SCAN_BASE sse2
+#else
+#define TOPAZ_SCAN_BASE scalar
+#endif
+
+    /**
+     * @brief Function for finding end of identifier
+     *
+     * @param p Start of scanning
+     * @param end End of source
+     *
+     * @return Pointer to the first character which is not letter, digit or '_'
+     */
+    inline const char *find_id_end(const char *p, const char *end) {
+        return TOPAZ_SCAN_CALL(find_id_end, p, end);
+    }
+
+    /**
+     * @brief Function for finding end of digits of number literal
+     *
+     * @param p Start of scanning
+     * @param end End of source
+     *
+     * @return Pointer to the first character which is not digit or '_'
+     */
+    inline const char *find_digits_end(const char *p, const char *end) {
+        return TOPAZ_SCAN_CALL(find_digits_end, p, end);
+    }
+
+    /**
+     * @brief Function for finding first character of string literal which needs handling (closing quote, escape or newline)
+     *
+     * @param p Start of scanning
+     * @param end End of source
+     * @param quote Closing quote
+     *
+     * @return Pointer to the found character or end of source
+     */
+    inline const char *find_string_special(const char *p, const char *end, char quote) {
+        return TOPAZ_SCAN_CALL(find_string_special, p, end, quote);
+    }
+
+    /**
+     * @brief Function for finding end of line
+     *
+     * @param p Start of scanning
+     * @param end End of source
+     *
+     * @return Pointer to the newline character or end of source
+     */
+    inline const char *find_line_end(const char *p, const char *end) {
+        return TOPAZ_SCAN_CALL(find_line_end, p, end);
+    }
+
+    /**
+     * @brief Function for skipping whitespaces (spaces and newlines) with counting of newlines
+     *
+     * @param p Start of scanning
+     * @param end End of source
+     * @param newlines Count of skipped newlines (increased)
+     * @param line_start Pointer after the last skipped newline (unchanged if no newline is skipped)
+     *
+     * @return Pointer to the first character which is not whitespace
+     */
+    inline const char *skip_whitespaces(const char *p, const char *end, uint32_t& newlines, const char *&line_start) {
+        return TOPAZ_SCAN_CALL(skip_whitespaces, p, end, newlines, line_start);
+    }
+
+#undef TOPAZ_SCAN_CALL
+#undef TOPAZ_SCAN_BASE
+}
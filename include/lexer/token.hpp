@@ -6,6 +6,8 @@
 
 #pragma once
 #include <cstdint>
+#include <string_view>
+#include <type_traits>
 #include <sstream>
 #include <string>
 
@@ -77,27 +79,63 @@ typedef enum : uint8_t {
     TOK_OP_NEXT                             /**< '->' operator */
 } TokenType;
 
+/**
+ * @brief Function for getting spelling of token with fixed text (keywords and operators)
+ *
+ * @param type Token type
+ *
+ * @return Spelling of token or empty string for identifiers and literals
+ */
+inline const char *get_token_spelling(TokenType type) {
+    static const char *const spellings[] = {
+        "bool", "char", "short", "int", "long", "float", "double", "noth",
+        "let", "fun", "if", "else", "for", "while", "const", "return",
+        "", "", "", "", "", "", "", "", "",
+        "+", "+=", "++", "-", "-=", "--", "*", "*=", "/", "/=", "%", "%=", "=", "==", "!=", ">", ">=", "<", "<=",
+        "!", "&&", "||", ",", ".", ":", ";", "(", ")", "{", "}", "[", "]", "?", "->"
+    };
+    static_assert(sizeof(spellings) / sizeof(spellings[0]) == TOK_OP_NEXT + 1, "Spelling is required for every token type");
+    return spellings[type];
+}
+
+/**
+ * @brief Value of number literal (parsed by lexer)
+ */
+union NumberValue {
+    int64_t int_value;                      /**< Value of integer literal */
+    double float_value;                     /**< Value of floating point literal ('float' values are exactly representable) */
+};
+
 /**
  * @brief Token structure
+ *
+ * Token is a small trivially copyable record: its text is a span of the source buffer registered in the SourceManager, and value
+ * of number literal is kept in the table of the lexer
  */
 struct Token {
     TokenType type;                         /**< Token type */
-    std::string value;                      /**< Token value */
+    uint16_t file_id;                       /**< ID of the file containing the token (in the SourceManager) */
+    uint32_t offset;                        /**< Offset of the token text in the source */
+    uint32_t length;                        /**< Length of the token text */
 
     uint32_t line;                          /**< Token line coordinate */
     uint32_t column;                        /**< Token column coordinate */
-    std::string file_name;                  /**< Name of the file containing the token */
 
-    Token(TokenType t, std::string v, uint32_t l, uint32_t c, std::string fn) : type(t), value(v), line(l), column(c), file_name(fn) {}
+    uint32_t value_index;                   /**< Index of value of number literal in the lexer or slot in ring buffer of TokenStream */
+
+    Token() = default;
+    Token(TokenType t, uint16_t f, uint32_t o, uint32_t len, uint32_t l, uint32_t c) : type(t), file_id(f), offset(o), length(len), line(l), column(c), value_index(0) {}
 
     /**
      * @brief Method for converting token to string
      *
      * This method converting token structure to string. If type of token is unsupported
      *
+     * @param text Token text (from the SourceManager)
+     *
      * @return String as converted token
      */
-    std::string to_str() {
+    std::string to_str(std::string_view text) const {
         std::stringstream ss;
         switch (type) {
             case TOK_CHAR:
@@ -274,7 +312,10 @@ struct Token {
                 ss << "<unknown>";
                 break;
         }
-        ss << " : '" << value << "' (" << column << ':' << line << ')';
+        ss << " : '" << text << "' (" << column << ':' << line << ')';
         return ss.str();
     }
-};
\ No newline at end of file
+};
+
+static_assert(std::is_trivially_copyable_v<Token>, "Token must be trivially copyable");
+static_assert(sizeof(Token) <= 24, "Token must stay compact");
\ No newline at end of file
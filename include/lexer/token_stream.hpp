@@ -0,0 +1,118 @@
+/**
+ * @file token_stream.hpp
+ *
+ * @brief Header file for defining the stream of tokens consumed by parser
+ */
+
+#pragma once
+#include "lexer.hpp"
+#include "token.hpp"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Stream of tokens
+ *
+ * Stream pulls tokens from the lexer on demand into the ring buffer sized to the parser lookahead, so memory of tokens does not depend
+ * on size of the source and lexing is interleaved with parsing. Values of number literals are kept in the ring buffer too.
+ * Stream can also be created from already tokenized vector
+ */
+class TokenStream {
+public:
+    static constexpr uint32_t LOOKBEHIND = 2;                   /**< Count of consumed tokens which stay available (peek(-2)) */
+    static constexpr uint32_t LOOKAHEAD = 1;                    /**< Count of tokens after the current one which are available (peek(1)) */
+
+private:
+    static constexpr uint32_t WINDOW_SIZE = 4;                  /**< Size of ring buffer (power of two which fits lookbehind, current token and lookahead) */
+    static_assert(WINDOW_SIZE >= LOOKBEHIND + 1 + LOOKAHEAD && (WINDOW_SIZE & (WINDOW_SIZE - 1)) == 0, "Ring buffer must fit parser lookahead");
+
+    Lexer *lexer;                                               /**< Lexer which produces tokens (nullptr for stream over vector) */
+    const Lexer *tokens_lexer;                                  /**< Lexer which tokenized vector (owns values of number literals, stream over vector only) */
+    std::vector<Token> tokens;                                  /**< Tokens (stream over vector only) */
+    Token window[WINDOW_SIZE];                                  /**< Ring buffer of the last read tokens (stream over lexer only) */
+    NumberValue window_values[WINDOW_SIZE];                     /**< Values of number literals of tokens in ring buffer (stream over lexer only) */
+    uint32_t pos;                                               /**< Index of the current token */
+    uint32_t count;                                             /**< Count of read tokens */
+    bool exhausted;                                             /**< Flag 'all tokens are read' */
+
+public:
+    TokenStream(Lexer& l) : lexer(&l), tokens_lexer(nullptr), pos(0), count(0), exhausted(false) {}
+    TokenStream(std::vector<Token> t, const Lexer& l) : lexer(nullptr), tokens_lexer(&l), tokens(std::move(t)), pos(0), count(tokens.size()),
+                                                        exhausted(true) {}
+
+    /**
+     * @brief Method for checking that token by stream pos and passed offset is available
+     *
+     * This method reads tokens from the lexer up to the requested one. Token is unavailable if it is after the end of the source,
+     * before the first token or already dropped from ring buffer (offset is less than -LOOKBEHIND)
+     *
+     * @param rpos Offset
+     *
+     * @return 'true' if token is available and 'false' otherwise
+     */
+    bool has(int32_t rpos);
+
+    /**
+     * @brief Method for getting token by stream pos and passed offset
+     *
+     * Token must be checked with has() before
+     *
+     * @param rpos Offset
+     *
+     * @return Token
+     */
+    const Token& get(int32_t rpos) const {
+        uint32_t index = pos + rpos;
+        return lexer == nullptr ? tokens[index] : window[index & (WINDOW_SIZE - 1)];
+    }
+
+    /**
+     * @brief Method for getting value of number literal token
+     *
+     * @param token Number literal token read from this stream (stream over lexer keeps values only of tokens in ring buffer)
+     *
+     * @return Parsed value of literal
+     */
+    const NumberValue& get_number_value(const Token& token) const {
+        return lexer == nullptr ? tokens_lexer->get_number_value(token) : window_values[token.value_index];
+    }
+
+    /**
+     * @brief Method for checking that all tokens are consumed
+     *
+     * @return 'true' if there is no current token and 'false' otherwise
+     */
+    bool at_end() {
+        return !has(0);
+    }
+
+    /**
+     * @brief Method for skipping the current token
+     */
+    void advance() {
+        pos++;
+    }
+
+    /**
+     * @brief Method for getting index of the current token
+     *
+     * @return Index of the current token
+     */
+    uint32_t get_pos() const {
+        return pos;
+    }
+
+    /**
+     * @brief Method for getting the last read token (for errors at the end of file)
+     *
+     * @return Pointer to the last read token or nullptr if no tokens are read
+     */
+    const Token *get_last() const;
+
+    /**
+     * @brief Method for rewinding stream to the first token
+     *
+     * Stream over lexer restarts the lexer from the beginning of the source
+     */
+    void reset();
+};
@@ -0,0 +1,145 @@
+/**
+ * @file linker.hpp
+ *
+ * @brief Header file for defining the linker of object files into executable
+ */
+
+#pragma once
+#include "../optimizer/optimizer.hpp"
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/TargetParser/Triple.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Linker kinds
+ */
+enum LinkerKind : uint8_t {
+    LINKER_EXTERNAL,                            /**< External linker driver ('clang' or $TOPAZC_LINKER) spawned as process */
+    LINKER_LLD                                  /**< lld linked into topazc and called in-process */
+};
+
+/**
+ * @brief Linker class
+ */
+class Linker {
+private:
+    LinkerKind kind;                                                            /**< Kind of linker */
+    llvm::Triple triple;                                                        /**< Target triple */
+    std::string output_path;                                                    /**< Path to the output executable */
+    std::vector<std::string> object_paths;                                      /**< Object files on disk */
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> object_buffers;            /**< Object files in memory */
+    bool thin_lto = false;                                                      /**< Flag 'inputs are ThinLTO bitcode files' */
+    uint32_t lto_jobs = 0;                                                      /**< Count of parallel ThinLTO backend jobs (0 for all cores) */
+    OptLevel lto_opt_level = OPT_O2;                                            /**< Optimization level of ThinLTO backend */
+    bool profile_runtime = false;                                               /**< Flag 'link profile runtime of instrumented code' */
+    std::string lto_sample_profile;                                             /**< Sample profile for ThinLTO backend (empty for none) */
+
+public:
+    Linker(LinkerKind k, llvm::Triple t, std::string op) : kind(k), triple(t), output_path(op) {}
+
+    /**
+     * @brief Method for adding object file from disk
+     *
+     * @param path Path to the object file
+     */
+    void add_object_file(std::string path) {
+        object_paths.push_back(path);
+    }
+
+    /**
+     * @brief Method for adding object file from memory
+     *
+     * Object files from memory are supported only by in-process linker. For external linker they are written into temporary files
+     *
+     * @param buffer Object file contents
+     */
+    void add_object_buffer(std::unique_ptr<llvm::MemoryBuffer> buffer) {
+        object_buffers.push_back(std::move(buffer));
+    }
+
+    /**
+     * @brief Method for enabling ThinLTO
+     *
+     * After this call all inputs are treated as ThinLTO bitcode with summaries. Linker runs the ThinLTO backend in parallel
+     * (cross-module importing, optimization and code generation) before linking
+     *
+     * @param jobs Count of parallel backend jobs (0 for all cores)
+     * @param level Optimization level of backend
+     */
+    void enable_thin_lto(uint32_t jobs, OptLevel level) {
+        thin_lto = true;
+        lto_jobs = jobs;
+        lto_opt_level = level;
+    }
+
+    /**
+     * @brief Method for setting sample profile of ThinLTO backend
+     *
+     * @param path Path to the sample profile
+     */
+    void set_lto_sample_profile(std::string path) {
+        lto_sample_profile = path;
+    }
+
+    /**
+     * @brief Method for enabling profile runtime
+     *
+     * Profile runtime (compiler-rt 'profile' library) writes '.profraw' profile of instrumented code at exit. External linker driver
+     * finds it by itself, in-process linker takes it from $TOPAZC_PROFILE_RT
+     */
+    void enable_profile_runtime() {
+        profile_runtime = true;
+    }
+
+    /**
+     * @brief Method for linking all added object files into executable
+     *
+     * This method links all added object files. If linking is failed, then the linker output is written into passed reference
+     *
+     * @param error Linker output in case of fail
+     *
+     * @return 'true' if linking is success and 'false' otherwise
+     */
+    bool link(std::string& error);
+
+private:
+    /**
+     * @brief Method for linking with external linker driver
+     *
+     * @param inputs Paths to all object files
+     * @param error Linker output in case of fail
+     *
+     * @return 'true' if linking is success and 'false' otherwise
+     */
+    bool link_external(const std::vector<std::string>& inputs, std::string& error);
+
+    /**
+     * @brief Method for linking with lld in-process
+     *
+     * This method builds arguments of 'ld.lld' (startup files, C library and dynamic linker of the host) and calls lld's ELF driver
+     *
+     * @param inputs Paths to all object files
+     * @param error Linker output in case of fail
+     *
+     * @return 'true' if linking is success and 'false' otherwise
+     */
+    bool link_lld(const std::vector<std::string>& inputs, std::string& error);
+
+    /**
+     * @brief Method for making path to object file from memory
+     *
+     * For in-process linker on Linux this method puts the buffer into anonymous memory file and returns '/proc/self/fd/<fd>' path,
+     * so the object never touches the disk. Otherwise the buffer is written into temporary file
+     *
+     * @param buffer Object file contents
+     * @param temp_files Temporary files which should be removed after linking
+     * @param fds File descriptors which should be closed after linking
+     * @param error Error message in case of fail
+     *
+     * @return Path to the object file or empty string in case of fail
+     */
+    std::string materialize_buffer(llvm::MemoryBuffer& buffer, std::vector<std::string>& temp_files, std::vector<int>& fds, std::string& error);
+};
@@ -0,0 +1,107 @@
+/**
+ * @file memory.hpp
+ *
+ * @brief Header file for defining the memory usage report of compiler phases
+ */
+
+#pragma once
+#include "../lexer/token.hpp"
+#include <llvm/Support/raw_ostream.h>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Structure of memory usage sample of the process
+ */
+struct MemorySample {
+    size_t rss = 0;                                                             /**< Resident set size in bytes */
+    size_t peak_rss = 0;                                                        /**< High-water mark of resident set size in bytes */
+    size_t heap = 0;                                                            /**< Heap bytes in use (0 if allocator statistics are unavailable) */
+    size_t heap_reserved = 0;                                                   /**< Heap bytes obtained from the system (0 if allocator statistics are unavailable) */
+};
+
+/**
+ * @brief Function for sampling current memory usage of the process
+ *
+ * RSS is read from '/proc/self/statm', peak RSS from getrusage and heap statistics from glibc mallinfo2
+ *
+ * @return Memory usage sample
+ */
+MemorySample sample_memory();
+
+/**
+ * @brief Function for getting heap growth between two samples
+ *
+ * @param before Sample before building a structure
+ * @param after Sample after building a structure
+ *
+ * @return Count of heap bytes allocated in between (0 if heap shrank)
+ */
+size_t get_heap_growth(const MemorySample& before, const MemorySample& after);
+
+/**
+ * @brief Function for estimating memory of token vector
+ *
+ * @param tokens Tokens
+ *
+ * @return Bytes of the vector storage (tokens are flat records, their texts stay in the source)
+ */
+size_t get_tokens_memory(const std::vector<Token>& tokens);
+
+/**
+ * @brief Memory report of compilation of one source file
+ *
+ * Collects memory samples after compiler phases and sizes of compiler structures. Sizes of structures which are not flat
+ * (AST, semantic tables, LLVM module) are measured as heap growth while they are built, so sources have to be compiled sequentially
+ */
+class MemoryReport {
+private:
+    /**
+     * @brief Structure of memory sample after phase
+     */
+    struct Phase {
+        std::string name;                                                       /**< Name of the phase */
+        MemorySample sample;                                                    /**< Memory usage after the phase */
+    };
+
+    /**
+     * @brief Structure of memory of compiler structure
+     */
+    struct Structure {
+        std::string name;                                                       /**< Name of the structure */
+        size_t bytes;                                                           /**< Size of the structure in bytes */
+    };
+
+    std::string file_name;                                                      /**< Name of the compiled source file */
+    std::vector<Phase> phases;                                                  /**< Samples after phases */
+    std::vector<Structure> structures;                                          /**< Sizes of compiler structures */
+    size_t max_sampled_heap = 0;                                                /**< Maximum of heap usage sampled after phases (not a true high-water mark) */
+
+public:
+    MemoryReport(std::string fn) : file_name(fn) {}
+
+    /**
+     * @brief Method for sampling memory after phase
+     *
+     * @param name Name of the phase
+     *
+     * @return Sample of memory usage
+     */
+    const MemorySample& record_phase(const std::string& name);
+
+    /**
+     * @brief Method for recording size of compiler structure
+     *
+     * @param name Name of the structure
+     * @param bytes Size of the structure in bytes
+     */
+    void record_structure(const std::string& name, size_t bytes);
+
+    /**
+     * @brief Method for printing the report
+     *
+     * @param os Output stream
+     */
+    void print(llvm::raw_ostream& os) const;
+};
@@ -0,0 +1,94 @@
+/**
+ * @file optimizer.hpp
+ *
+ * @brief Header file for defining the LLVM IR optimizer
+ */
+
+#pragma once
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Support/CodeGen.h>
+#include <llvm/IR/Module.h>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Optimization levels
+ */
+enum OptLevel : uint8_t {
+    OPT_O0,                                     /**< '-O0' no optimizations */
+    OPT_O1,                                     /**< '-O1' fast optimizations */
+    OPT_O2,                                     /**< '-O2' default optimizations */
+    OPT_O3,                                     /**< '-O3' aggressive optimizations */
+    OPT_OS,                                     /**< '-Os' optimizations for code size */
+    OPT_OZ                                      /**< '-Oz' aggressive optimizations for code size */
+};
+
+/**
+ * @brief Kinds of profile-guided optimization
+ */
+enum ProfileKind : uint8_t {
+    PROFILE_NONE,                               /**< No profile */
+    PROFILE_GENERATE,                           /**< Instrument code for writing '.profraw' profile */
+    PROFILE_USE,                                /**< Use merged '.profdata' profile of instrumented code */
+    PROFILE_SAMPLE_USE                          /**< Use sample profile (for example, converted from 'perf record' data) */
+};
+
+/**
+ * @brief Structure of profile-guided optimization options
+ */
+struct ProfileOptions {
+    ProfileKind kind = PROFILE_NONE;            /**< Kind of profile-guided optimization */
+    std::string path;                           /**< Path to the profile ('.profraw' pattern for generation, '.profdata' or sample profile for use) */
+    bool debug_info = false;                    /**< Flag 'module has line tables for profiling' (adds discriminators) */
+};
+
+/**
+ * @brief Function for parsing optimization level option
+ *
+ * This function parsing option such as '-O2' and writes parsed level into passed reference
+ *
+ * @param option Command line option
+ * @param level Parsed optimization level
+ *
+ * @return 'true' if option is optimization level and 'false' otherwise
+ */
+bool parse_opt_level(const std::string& option, OptLevel& level);
+
+/**
+ * @brief Optimizer class
+ *
+ * Runs the standard LLVM module pipeline built by PassBuilder over the module from CodeGenerator
+ */
+class Optimizer {
+private:
+    llvm::TargetMachine *target_machine;                                        /**< Target machine (for target-specific analyses) */
+    OptLevel level;                                                             /**< Optimization level */
+    ProfileOptions profile;                                                     /**< Profile-guided optimization options */
+
+public:
+    Optimizer(llvm::TargetMachine *tm, OptLevel l, ProfileOptions p = {}) : target_machine(tm), level(l), profile(p) {}
+
+    /**
+     * @brief Method for optimizing LLVM Module
+     *
+     * This method building the PassBuilder module pipeline for current optimization level and runs it over passed module.
+     * If stream for ThinLTO bitcode is passed, then ThinLTO pre-link pipeline is used and module is written into stream
+     * as bitcode with module summary (code generation is done by the linker)
+     *
+     * @param module Module for optimizing
+     * @param thin_lto_bitcode Stream for ThinLTO bitcode (nullptr for usual compilation)
+     */
+    void optimize(llvm::Module& module, llvm::raw_ostream *thin_lto_bitcode = nullptr);
+
+    /**
+     * @brief Method for getting code generation optimization level
+     *
+     * This method converting optimization level to the level which should be passed to the TargetMachine
+     *
+     * @param level Optimization level
+     *
+     * @return Code generation optimization level
+     */
+    static llvm::CodeGenOptLevel get_codegen_opt_level(OptLevel level);
+};
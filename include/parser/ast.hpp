@@ -2,6 +2,8 @@
  * @file ast.hpp
  *
  * @brief Header file for defining AST tree elements
+ *
+ * Nodes are allocated in ASTContext and their destructors are never run, so nodes keep only views and spans into the context
  */
 
 #pragma once
@@ -11,10 +13,10 @@
 #include <uchar.h>
 #include <utility>
 #include <variant>
+#include <string_view>
 #include <string>
-#include <memory>
 #include <cmath>
-#include <vector>
+#include <span>
 
 namespace AST {
     /**
@@ -33,18 +35,70 @@ namespace AST {
         TYPE_TRAIT,                              /**< Trait type */
         TYPE_CLASS,                              /**< Class type */
     };
+    /**
+     * @brief Binary operators enum
+     *
+     * Operators keep the relative order of their tokens: arithmetic, equality, comparison and logical operators are contiguous ranges
+     */
+    enum BinaryOp : uint8_t {
+        BIN_OP_PLUS,                            /**< '+' operator */
+        BIN_OP_MINUS,                           /**< '-' operator */
+        BIN_OP_MULT,                            /**< '*' operator */
+        BIN_OP_DIV,                             /**< '/' operator */
+        BIN_OP_MODULO,                          /**< '%' operator */
+        BIN_OP_EQ_EQ,                           /**< '==' operator */
+        BIN_OP_NOT_EQ_EQ,                       /**< '!=' operator */
+        BIN_OP_GT,                              /**< '>' operator */
+        BIN_OP_GT_EQ,                           /**< '>=' operator */
+        BIN_OP_LS,                              /**< '<' operator */
+        BIN_OP_LS_EQ,                           /**< '<=' operator */
+        BIN_OP_L_AND,                           /**< '&&' (logical and) operator */
+        BIN_OP_L_OR,                            /**< '||' (logical or) operator */
+    };
+
+    /**
+     * @brief Unary operators enum
+     */
+    enum UnaryOp : uint8_t {
+        UN_OP_MINUS,                            /**< '-' operator */
+        UN_OP_L_NOT,                            /**< '!' (logical negative) operator */
+    };
+
+    /**
+     * @brief Function for getting spelling of binary operator
+     *
+     * @param op Binary operator
+     *
+     * @return Spelling of operator
+     */
+    inline const char *get_binary_op_spelling(BinaryOp op) {
+        static const char *const spellings[] = { "+", "-", "*", "/", "%", "==", "!=", ">", ">=", "<", "<=", "&&", "||" };
+        static_assert(sizeof(spellings) / sizeof(spellings[0]) == BIN_OP_L_OR + 1, "Spelling is required for every binary operator");
+        return spellings[op];
+    }
+
+    /**
+     * @brief Function for getting spelling of unary operator
+     *
+     * @param op Unary operator
+     *
+     * @return Spelling of operator
+     */
+    inline const char *get_unary_op_spelling(UnaryOp op) {
+        return op == UN_OP_MINUS ? "-" : "!";
+    }
     
     /**
      * @brief Structure for describing the type
      */
     struct Type {
         TypeValue type;                         /**< Enum type */
-        std::string name;                       /**< String name of type */
+        std::string_view name;                  /**< String name of type */
         bool is_const;                          /**< Flag 'is constant type' */
         bool is_ptr;                            /**< Flag 'is raw pointer type' */
         bool is_nullable;                       /**< Flag 'is nullable type' */
         
-        Type(TypeValue t, std::string n, bool ic = false, bool ip = false, bool in = false) : type(t), name(n), is_const(ic), is_ptr(ip), is_nullable(in) {}
+        Type(TypeValue t, std::string_view n, bool ic = false, bool ip = false, bool in = false) : type(t), name(n), is_const(ic), is_ptr(ip), is_nullable(in) {}
 
         bool operator ==(Type& other) {
             return type == other.type && name == other.name && is_const == other.is_const && is_ptr == other.is_ptr && is_nullable == other.is_nullable;
@@ -68,23 +122,23 @@ namespace AST {
      * @brief Structure for describing the value
      */
     struct Value {
-        std::variant<bool, char8_t, int16_t, int32_t, int64_t, float_t, double_t, std::string> value;               /**< Value as variant between char, short, int, long, float, double, bool and string */
+        std::variant<bool, char8_t, int16_t, int32_t, int64_t, float, double, std::string_view> value;          /**< Value as variant between char, short, int, long, float, double, bool and string (view into ASTContext) */
 
         Value(bool v)               : value(v) {}
         Value(char8_t v)            : value(v) {}
         Value(int16_t v)            : value(v) {}
         Value(int32_t v)            : value(v) {}
         Value(int64_t v)            : value(v) {}
-        Value(float_t v)            : value(v) {}
-        Value(double_t v)           : value(v) {}
-        Value(std::string v)        : value(v) {}
+        Value(float v)              : value(v) {}
+        Value(double v)             : value(v) {}
+        Value(std::string_view v)   : value(v) {}
     };
 
     struct Argument {
-        std::string name;
+        std::string_view name;
         Type type;
 
-        Argument(std::string n, Type t) : name(n), type(t) {}
+        Argument(std::string_view n, Type t) : name(n), type(t) {}
     };
     
     /**
@@ -109,21 +163,33 @@ namespace AST {
         virtual ~Expr() = default;
     };
 
-    using StmtPtr = std::unique_ptr<Stmt>;
-    using ExprPtr = std::unique_ptr<Expr>;
+    using StmtPtr = Stmt *;                 /**< Statement (allocated in ASTContext) */
+    using ExprPtr = Expr *;                 /**< Expression (allocated in ASTContext) */
 
     // EXPRESSIONS
 
     /**
      * @brief Base class of literal
+     *
+     * Literal keeps only kind of its type and pointer to the value in the constant pool of ASTContext (equal literals share one value)
      */
     class Literal : public Expr {
     public:
-        Type type;                          /**< Type of literal */
-        Value value;                        /**< Value of literal */
+        TypeValue kind;                     /**< Type of literal */
+        const Value *value;                 /**< Value of literal (in the constant pool of ASTContext) */
 
-        Literal(Type t, Value v, uint32_t l) : type(t), value(v), Expr(l) {}
+        Literal(TypeValue k, const Value *v, uint32_t l) : kind(k), value(v), Expr(l) {}
         ~Literal() override = default;
+
+        /**
+         * @brief Method for getting type of literal
+         *
+         * @return Type of literal
+         */
+        Type get_type() const {
+            static const char *const names[] = { "bool", "char", "short", "int", "long", "float", "double", "noth", "string" };
+            return Type(kind, names[kind]);
+        }
     };
 
     /**
@@ -131,16 +197,16 @@ namespace AST {
      */
     class BoolLiteral : public Literal {
     public:
-        BoolLiteral(bool v, uint32_t l) : Literal(Type(TYPE_BOOL, "bool"), Value(v), l) {}
+        BoolLiteral(const Value *v, uint32_t l) : Literal(TYPE_BOOL, v, l) {}
         ~BoolLiteral() override = default;
     };
-    
+
     /**
      * @brief Character literal
      */
     class CharacterLiteral : public Literal {
     public:
-        CharacterLiteral(char8_t v, uint32_t l) : Literal(Type(TYPE_CHAR, "char"), Value(v), l) {}
+        CharacterLiteral(const Value *v, uint32_t l) : Literal(TYPE_CHAR, v, l) {}
         ~CharacterLiteral() override = default;
     };
 
@@ -149,7 +215,7 @@ namespace AST {
      */
     class ShortLiteral : public Literal {
     public:
-        ShortLiteral(int16_t v, uint32_t l) : Literal(Type(TYPE_SHORT, "short"), Value(v), l) {}
+        ShortLiteral(const Value *v, uint32_t l) : Literal(TYPE_SHORT, v, l) {}
         ~ShortLiteral() override = default;
     };
 
@@ -158,7 +224,7 @@ namespace AST {
      */
     class IntLiteral : public Literal {
     public:
-        IntLiteral(int32_t v, uint32_t l) : Literal(Type(TYPE_INT, "int"), Value(v), l) {}
+        IntLiteral(const Value *v, uint32_t l) : Literal(TYPE_INT, v, l) {}
         ~IntLiteral() override = default;
     };
 
@@ -167,7 +233,7 @@ namespace AST {
      */
     class LongLiteral : public Literal {
     public:
-        LongLiteral(int64_t v, uint32_t l) : Literal(Type(TYPE_LONG, "long"), Value(v), l) {}
+        LongLiteral(const Value *v, uint32_t l) : Literal(TYPE_LONG, v, l) {}
         ~LongLiteral() override = default;
     };
 
@@ -176,7 +242,7 @@ namespace AST {
      */
     class FloatLiteral : public Literal {
     public:
-        FloatLiteral(float_t v, uint32_t l) : Literal(Type(TYPE_FLOAT, "float"), Value(v), l) {}
+        FloatLiteral(const Value *v, uint32_t l) : Literal(TYPE_FLOAT, v, l) {}
         ~FloatLiteral() override = default;
     };
 
@@ -185,7 +251,7 @@ namespace AST {
      */
     class DoubleLiteral : public Literal {
     public:
-        DoubleLiteral(double_t v, uint32_t l) : Literal(Type(TYPE_DOUBLE, "double"), Value(v), l) {}
+        DoubleLiteral(const Value *v, uint32_t l) : Literal(TYPE_DOUBLE, v, l) {}
         ~DoubleLiteral() override = default;
     };
 
@@ -194,7 +260,7 @@ namespace AST {
      */
     class StringLiteral : public Literal {
     public:
-        StringLiteral(std::string v, uint32_t l) : Literal(Type(TYPE_STRING_LIT, "string"), Value(v), l) {}
+        StringLiteral(const Value *v, uint32_t l) : Literal(TYPE_STRING_LIT, v, l) {}
         ~StringLiteral() override = default;
     };
 
@@ -205,11 +271,11 @@ namespace AST {
      */
     class BinaryExpr : public Expr {
     public:
-        Token op;                                               /**< Binary operator (+, -, *, /, &&, ||, !=, ==, >, >=, <, <=) */
+        BinaryOp op;                                            /**< Binary operator (+, -, *, /, &&, ||, !=, ==, >, >=, <, <=) */
         ExprPtr left_expr;                                      /**< Expression of left operand */
         ExprPtr right_expr;                                     /**< Expression of right operand */
 
-        BinaryExpr(Token o, ExprPtr le, ExprPtr re, uint32_t l) : op(o), left_expr(std::move(le)), right_expr(std::move(re)), Expr(l) {}
+        BinaryExpr(BinaryOp o, ExprPtr le, ExprPtr re, uint32_t l) : op(o), left_expr(le), right_expr(re), Expr(l) {}
         ~BinaryExpr() override = default;
     };
 
@@ -220,10 +286,10 @@ namespace AST {
      */
     class UnaryExpr : public Expr {
     public:
-        Token op;                                               /**< Unary operator (-, !) */
+        UnaryOp op;                                             /**< Unary operator (-, !) */
         ExprPtr expr;                                           /**< Expression of operand */
 
-        UnaryExpr(Token o, ExprPtr e, uint32_t l) : op(o), expr(std::move(e)), Expr(l) {}
+        UnaryExpr(UnaryOp o, ExprPtr e, uint32_t l) : op(o), expr(e), Expr(l) {}
         ~UnaryExpr() override = default;
     };
 
@@ -234,9 +300,9 @@ namespace AST {
      */
     class VarExpr : public Expr {
     public:
-        std::string name;                                       /**< Variable name */
+        std::string_view name;                                  /**< Variable name */
 
-        VarExpr(std::string n, uint32_t l) : name(n), Expr(l) {}
+        VarExpr(std::string_view n, uint32_t l) : name(n), Expr(l) {}
         ~VarExpr() override = default;
     };
 
@@ -247,10 +313,10 @@ namespace AST {
      */
     class FuncCallExpr : public Expr {
     public:
-        std::string name;                                       /**< Function name */
-        std::vector<ExprPtr> args;                              /**< Function arguments */
+        std::string_view name;                                  /**< Function name */
+        std::span<ExprPtr> args;                                /**< Function arguments */
 
-        FuncCallExpr(std::string n, std::vector<ExprPtr> a, uint32_t l) : name(n), args(std::move(a)), Expr(l) {}
+        FuncCallExpr(std::string_view n, std::span<ExprPtr> a, uint32_t l) : name(n), args(a), Expr(l) {}
         ~FuncCallExpr() override = default;
     };
 
@@ -263,9 +329,9 @@ namespace AST {
     public:
         Type type;                                              /**< Variable type */
         ExprPtr expr;                                           /**< Variable initialization expression (maybe nullptr) */
-        std::string name;                                       /**< Variable name */
+        std::string_view name;                                  /**< Variable name */
 
-        VarDeclStmt(Type t, ExprPtr e, std::string n, uint32_t l) : type(t), expr(std::move(e)), name(n), Stmt(l) {}
+        VarDeclStmt(Type t, ExprPtr e, std::string_view n, uint32_t l) : type(t), expr(e), name(n), Stmt(l) {}
         ~VarDeclStmt() override = default;
     };
 
@@ -274,10 +340,10 @@ namespace AST {
      */
     class VarAsgnStmt : public Stmt {
     public:
-        std::string name;                                       /**< Variable name */
+        std::string_view name;                                  /**< Variable name */
         ExprPtr expr;                                           /**< New expression */
 
-        VarAsgnStmt(std::string n, ExprPtr e, uint32_t l) : name(n), expr(std::move(e)), Stmt(l) {}
+        VarAsgnStmt(std::string_view n, ExprPtr e, uint32_t l) : name(n), expr(e), Stmt(l) {}
         ~VarAsgnStmt() override = default;
     };
 
@@ -286,12 +352,12 @@ namespace AST {
      */
     class FuncDeclStmt : public Stmt {
     public:
-        std::string name;                                       /**< Function name */
-        std::vector<Argument> args;                             /**< Functions arguments */
+        std::string_view name;                                  /**< Function name */
+        std::span<Argument> args;                               /**< Functions arguments */
         Type ret_type;                                          /**< Function return type */
-        std::vector<StmtPtr> block;                             /**< Function block */
+        std::span<StmtPtr> block;                               /**< Function block */
 
-        FuncDeclStmt(std::string n, std::vector<Argument> a, Type rt, std::vector<StmtPtr> b, uint32_t l) : name(n), args(std::move(a)), ret_type(rt), block(std::move(b)), Stmt(l) {}
+        FuncDeclStmt(std::string_view n, std::span<Argument> a, Type rt, std::span<StmtPtr> b, uint32_t l) : name(n), args(a), ret_type(rt), block(b), Stmt(l) {}
         ~FuncDeclStmt() override = default;
     };
 
@@ -300,10 +366,10 @@ namespace AST {
      */
     class FuncCallStmt : public Stmt {
     public:
-        std::string name;                                       /**< Function name */
-        std::vector<ExprPtr> args;                              /**< Functions arguments as expressions */
+        std::string_view name;                                  /**< Function name */
+        std::span<ExprPtr> args;                                /**< Functions arguments as expressions */
 
-        FuncCallStmt(std::string n, std::vector<ExprPtr> a, uint32_t l) : name(n), args(std::move(a)), Stmt(l) {}
+        FuncCallStmt(std::string_view n, std::span<ExprPtr> a, uint32_t l) : name(n), args(a), Stmt(l) {}
         ~FuncCallStmt() override = default;
     };
 
@@ -314,7 +380,7 @@ namespace AST {
     public:
         ExprPtr expr;                                           /**< Returned expression */
 
-        ReturnStmt(ExprPtr e, uint32_t l) : expr(std::move(e)), Stmt(l) {}
+        ReturnStmt(ExprPtr e, uint32_t l) : expr(e), Stmt(l) {}
         ~ReturnStmt() override = default;
     };
 
@@ -324,9 +390,9 @@ namespace AST {
     class IfElseStmt : public Stmt {
     public:
         ExprPtr cond;                                           /**< Condition */
-        std::vector<StmtPtr> then_block;                        /**< Block for true branch */
-        std::vector<StmtPtr> else_block;                        /**< Block for false branch (not necessary) */
+        std::span<StmtPtr> then_block;                          /**< Block for true branch */
+        std::span<StmtPtr> else_block;                          /**< Block for false branch (not necessary) */
 
-        IfElseStmt(ExprPtr c, std::vector<StmtPtr> tb, std::vector<StmtPtr> eb, uint32_t l) : cond(std::move(c)), then_block(std::move(tb)), else_block(std::move(eb)), Stmt(l) {}
+        IfElseStmt(ExprPtr c, std::span<StmtPtr> tb, std::span<StmtPtr> eb, uint32_t l) : cond(c), then_block(tb), else_block(eb), Stmt(l) {}
     };
 }
\ No newline at end of file
@@ -0,0 +1,155 @@
+/**
+ * @file ast_context.hpp
+ *
+ * @brief Header file for defining the arena of AST tree
+ */
+
+#pragma once
+#include "ast.hpp"
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Arena of AST tree
+ *
+ * All nodes, child lists, identifier strings and literal values of one compilation are bump-allocated from slabs in creation order and freed at once
+ * with the context. Destructors of nodes are never run, so nodes may own nothing except views and spans into the context.
+ * Context is not thread-safe: every compilation uses its own context
+ */
+class ASTContext {
+private:
+    static constexpr size_t SLAB_SIZE = 64 << 10;                               /**< Size of usual slab */
+
+    std::vector<std::unique_ptr<char[]>> slabs;                                 /**< Allocated slabs */
+    char *cur = nullptr;                                                        /**< First free byte of the current slab */
+    char *end = nullptr;                                                        /**< End of the current slab */
+    size_t allocated_bytes = 0;                                                 /**< Count of bytes allocated for objects */
+    size_t slabs_bytes = 0;                                                     /**< Count of bytes of all slabs */
+    std::unordered_set<std::string_view> strings;                               /**< Interned strings (views into the slabs) */
+
+    using ConstantKey = decltype(AST::Value::value);
+
+    /**
+     * @brief Bitwise equality of constants (so 0.0 and -0.0 are different constants)
+     */
+    struct ConstantEqual {
+        bool operator()(const ConstantKey& left, const ConstantKey& right) const;
+    };
+
+    std::unordered_map<ConstantKey, const AST::Value *, std::hash<ConstantKey>, ConstantEqual> constants;      /**< Constant pool (values in the slabs) */
+
+public:
+    ASTContext() = default;
+    ASTContext(const ASTContext&) = delete;
+    ASTContext& operator=(const ASTContext&) = delete;
+
+    /**
+     * @brief Method for allocating raw memory
+     *
+     * @param size Size in bytes
+     * @param align Alignment (not greater than alignment of operator new)
+     *
+     * @return Pointer to the allocated memory
+     */
+    void *allocate(size_t size, size_t align) {
+        uintptr_t aligned = (reinterpret_cast<uintptr_t>(cur) + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        if (cur == nullptr || aligned + size > reinterpret_cast<uintptr_t>(end)) {
+            return allocate_slow(size);
+        }
+        cur = reinterpret_cast<char *>(aligned + size);
+        allocated_bytes += size;
+        return reinterpret_cast<void *>(aligned);
+    }
+
+    /**
+     * @brief Method for creating node in the arena
+     *
+     * @param args Arguments of node constructor
+     *
+     * @return Pointer to the node
+     */
+    template <typename T, typename... Args>
+    T *create(Args&&... args) {
+        static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "Node alignment is not supported by arena");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Method for copying list of children into the arena
+     *
+     * @param items Children
+     *
+     * @return Span of the copied children
+     */
+    template <typename T>
+    std::span<T> copy_array(const std::vector<T>& items) {
+        static_assert(std::is_trivially_destructible_v<T>, "Arena arrays are never destroyed");
+        if (items.empty()) {
+            return {};
+        }
+        T *data = static_cast<T *>(allocate(sizeof(T) * items.size(), alignof(T)));
+        std::uninitialized_copy(items.begin(), items.end(), data);
+        return std::span<T>(data, items.size());
+    }
+
+    /**
+     * @brief Method for interning string
+     *
+     * Equal strings are stored once, so names from different nodes share one copy
+     *
+     * @param str String
+     *
+     * @return View of the interned string (valid until the context is destroyed)
+     */
+    std::string_view intern(std::string_view str);
+
+    /**
+     * @brief Method for adding value to the constant pool
+     *
+     * Equal values are stored once, so literals keep only pointer to the shared value
+     *
+     * @param value Value (string values must be views into the context)
+     *
+     * @return Pointer to the value in the pool (valid until the context is destroyed)
+     */
+    const AST::Value *add_constant(AST::Value value);
+
+    /**
+     * @brief Method for getting count of bytes used by nodes, child lists and strings
+     *
+     * @return Count of allocated bytes
+     */
+    size_t get_allocated_bytes() const {
+        return allocated_bytes;
+    }
+
+    /**
+     * @brief Method for getting count of bytes of all slabs (including unused tails of slabs)
+     *
+     * @return Count of reserved bytes
+     */
+    size_t get_reserved_bytes() const {
+        return slabs_bytes;
+    }
+
+private:
+    /**
+     * @brief Method for allocating memory in a new slab
+     *
+     * Allocation bigger than quarter of slab gets its own slab, so the current slab is not wasted
+     *
+     * @param size Size in bytes
+     *
+     * @return Pointer to the allocated memory
+     */
+    void *allocate_slow(size_t size);
+};
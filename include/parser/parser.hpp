@@ -5,6 +5,9 @@
  */
 
 #pragma once
+#include "../source/source.hpp"
+#include "ast_context.hpp"
+#include "../lexer/token_stream.hpp"
 #include "../lexer/token.hpp"
 #include "ast.hpp"
 
@@ -13,17 +16,19 @@
  */
 class Parser {
 private:
-    std::vector<Token> tokens;                                  /**< Tokens (from Lexer) */
-    size_t tokens_count;                                        /**< Count of tokens */
-    uint32_t pos;                                               /**< Current position in tokens */
+    TokenStream tokens;                                         /**< Tokens (pulled from Lexer on demand or from tokenized vector) */
+    const SourceManager& sources;                               /**< Source manager with texts of tokens */
+    ASTContext& context;                                        /**< Arena of AST nodes and names */
 
 public:
-    Parser(std::vector<Token> t) : tokens(t), tokens_count(t.size()), pos(0) {}
+    Parser(Lexer& lex, const SourceManager& sm, ASTContext& ctx) : tokens(lex), sources(sm), context(ctx) {}
+    Parser(std::vector<Token> t, const Lexer& lex, const SourceManager& sm, ASTContext& ctx) : tokens(std::move(t), lex), sources(sm), context(ctx) {}
 
     /**
      * @brief Method for parsing tokens into AST tree
      *
-     * This method parsing all tokens, creates AST tree and returns it
+     * This method parsing all tokens, creates AST tree in the context and returns it
+     * Statements with syntax errors are reported into the diagnostics engine and skipped
      *
      * @return AST tree
      */
@@ -35,6 +40,26 @@ public:
     void reset();
 
 private:
+    /**
+     * @brief Method for parsing block of statements
+     *
+     * This method parsing statements until closing '}' (opening '{' is already consumed). Statement with syntax error is skipped
+     * up to the next statement of the block
+     *
+     * @param block Parsed statements
+     */
+    void parse_block(std::vector<AST::StmtPtr>& block);
+
+    /**
+     * @brief Method for skipping tokens after syntax error
+     *
+     * This method skipping tokens up to the end of failed statement: after ';' or nested block, or before '}' of enclosing block
+     * or keyword which starts a statement
+     *
+     * @param start Position of the first token of failed statement
+     */
+    void synchronize(uint32_t start);
+
     /**
      * @brief Method for parsing only one statement
      *
@@ -188,17 +213,50 @@ private:
      */
     AST::ExprPtr parse_primary_expr();
 
+    /**
+     * @brief Method for getting text of token
+     *
+     * @param token Token
+     *
+     * @return Token text
+     */
+    std::string get_text(const Token& token) const {
+        return std::string(sources.get_text(token));
+    }
+
+    /**
+     * @brief Method for getting interned text of token (for names in AST nodes)
+     *
+     * @param token Token
+     *
+     * @return Token text interned in the context
+     */
+    std::string_view get_name(const Token& token) {
+        return context.intern(sources.get_text(token));
+    }
+
+    /**
+     * @brief Method for getting name of the file containing token
+     *
+     * @param token Token
+     *
+     * @return Name of the file
+     */
+    const std::string& get_file_name(const Token& token) const {
+        return sources.get_file_name(token.file_id);
+    }
+
     /**
      * @brief Method for getting token from tokens by parser pos and passed offset
      *
      * This method getting getting token from tokens by parser pos and passed offset
-     * If pos + offset out of bounds of range tokens, then throwing exception
+     * If pos + offset out of bounds of range tokens (or out of lookahead of TokenStream), then throwing exception
      *
-     * @param rpos Offset
+     * @param rpos Offset (from -TokenStream::LOOKBEHIND to TokenStream::LOOKAHEAD)
      *
      * @return Token from tokens
      */
-    Token peek(int32_t rpos = 0) const;
+    Token peek(int32_t rpos = 0);
 
     /**
      * @brief Method for skipping the current token if its type is equal to the passed one
@@ -268,7 +326,7 @@ private:
      *
      * @return Assingment expression
      */
-    AST::ExprPtr create_compound_asgn_operator(std::string var_name);
+    AST::ExprPtr create_compound_asgn_operator(std::string_view var_name);
 
     /**
      * @brief Method for creating increment/decrement operator and returns expression of assignment
@@ -281,5 +339,5 @@ private:
      *
      * @return Increment/Decrement expression
      */
-    AST::ExprPtr create_inc_dec_operator(std::string var_name);
+    AST::ExprPtr create_inc_dec_operator(std::string_view var_name);
 };
\ No newline at end of file
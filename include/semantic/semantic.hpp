@@ -5,9 +5,14 @@
  */
 
 #include "../parser/ast.hpp"
+#include <string_view>
+#include <functional>
 #include <memory>
+#include <string>
 #include <stack>
+#include <deque>
 #include <map>
+#include <span>
 #include <vector>
 
 class SemanticAnalyzer {
@@ -34,17 +39,20 @@ private:
         Value(AST::Type t, AST::Value v) : type(t), value(v) {}
     };
 
-    std::stack<std::map<std::string, Value>> variables;                         /**< View scope of the variables table */
+    std::stack<std::map<std::string, Value, std::less<>>> variables;           /**< View scope of the variables table */
+    std::deque<std::string> string_values;                                      /**< Values of evaluated string expressions (string values of AST are views) */
 
     /**
      * @brief Structure of information about function
+     *
+     * Arguments and block are borrowed from the function declaration statement, so the AST tree stays owned by the caller
      */
     struct FunctionInfo {
         AST::Type ret_type;                                                     /**< Function return type */
-        std::vector<AST::Argument> args;                                        /**< Function arguments */
-        std::vector<AST::StmtPtr> block;                                        /**< Function block */
+        std::span<AST::Argument> args;                                          /**< Function arguments */
+        std::span<AST::StmtPtr> block;                                          /**< Function block */
     };
-    std::map<std::string, std::unique_ptr<FunctionInfo>> functions;             /**< Functions table */
+    std::map<std::string, std::unique_ptr<FunctionInfo>, std::less<>> functions;   /**< Functions table */
     std::stack<AST::Type> functions_ret_types;                                  /**< Stack of functions return types */
 
 public:
@@ -55,11 +63,22 @@ public:
     /**
      * @brief Method for analyze all statements
      *
-     * This method analyze all statements to semantic errors. If have error, then throwing exception
+     * This method analyze all statements to semantic errors. Errors are reported into the diagnostics engine and analysis
+     * continues with the next statement
      */
     void analyze();
 
 private:
+    /**
+     * @brief Method for analyze one statement with recovery after error
+     *
+     * This method analyze one statement. If statement has error, then scopes opened by it are closed, so analysis
+     * can continue with the next statement
+     *
+     * @param stmt Statement for analyzing
+     */
+    void analyze_stmt_with_recovery(AST::Stmt& stmt);
+
     /**
      * @brief Method for analyze one statement
      *
@@ -211,7 +230,7 @@ private:
      *
      * @return Evaluating function returned value or nullptr if does not have 'return'
      */
-    Value *get_function_return_value_from_if_else(AST::IfElseStmt& ies);
+    std::unique_ptr<Value> get_function_return_value_from_if_else(AST::IfElseStmt& ies);
 
     /**
      * @brief Method for getting default value by type
@@ -234,7 +253,7 @@ private:
      *
      * @return Value of variable
      */
-    std::unique_ptr<Value> get_variable_value(std::string name);
+    std::unique_ptr<Value> get_variable_value(std::string_view name);
 
     /**
      * @brief Method for getting info about function from functions table
@@ -245,7 +264,7 @@ private:
      *
      * @return Info about function
      */
-    FunctionInfo *get_function_info(std::string name);
+    FunctionInfo *get_function_info(std::string_view name);
 
     /**
      * @brief Method for determining whether two types have a common type
@@ -280,12 +299,12 @@ private:
      *
      * @param left Value of left operand
      * @param right Value of right operand
-     * @param op Type of binary operator
+     * @param op Binary operator
      * @param line Line coordinate in Topaz source code (for exception)
      *
      * @return Evaluating value
      */
-    double binary_two_variants(Value left, Value right, TokenType op, uint32_t line);
+    double binary_two_variants(Value left, Value right, AST::BinaryOp op, uint32_t line);
 
     /**
      * @brief Method for evaluating unary operations on two values from std::variant
@@ -294,10 +313,10 @@ private:
      *
      * @param left Value of left operand
      * @param right Value of right operand
-     * @param op Type of unary operator
+     * @param op Unary operator
      * @param line Line coordinate in Topaz source code (for exception)
      *
      * @return Evaluating value
      */
-    double unary_two_variants(Value value, TokenType op, uint32_t line);
+    double unary_two_variants(Value value, AST::UnaryOp op, uint32_t line);
 };
\ No newline at end of file
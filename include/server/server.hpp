@@ -0,0 +1,35 @@
+/**
+ * @file server.hpp
+ *
+ * @brief Header file for defining the persistent compile server and its thin client
+ */
+
+#pragma once
+#include <string>
+
+/**
+ * @brief Function for running the compile server
+ *
+ * Server initializes LLVM targets, detects the host and prewarms target machines once, then listens on Unix socket.
+ * Every request is compiled in a process forked from the server, so it reuses all prewarmed state and a fatal error of
+ * one request never kills the server. Output of the compilation goes directly into stdin/stdout/stderr passed by the client
+ *
+ * @param socket_path Path to the Unix socket
+ *
+ * @return Exit code of the server (only in case of fail)
+ */
+int run_server(const std::string& socket_path);
+
+/**
+ * @brief Function for running the compilation on the compile server
+ *
+ * Client sends command line arguments, working directory, environment and its stdin/stdout/stderr to the server and waits for exit code
+ *
+ * @param socket_path Path to the Unix socket of the server
+ * @param argc Count of arguments
+ * @param argv Arguments
+ * @param exit_code Exit code of the compilation
+ *
+ * @return 'true' if request is handled by the server and 'false' if server is unavailable (caller should compile by itself)
+ */
+bool run_client(const std::string& socket_path, int argc, const char *argv[], int& exit_code);
@@ -0,0 +1,77 @@
+/**
+ * @file source.hpp
+ *
+ * @brief Header file for defining the source manager
+ */
+
+#pragma once
+#include "../lexer/token.hpp"
+#include <string_view>
+#include <cstdint>
+#include <string>
+#include <deque>
+
+/**
+ * @brief Source manager class
+ *
+ * Maps 16-bit file IDs of tokens to file names and source buffers, so tokens keep only spans into the source.
+ * Buffers are owned by the caller and must outlive the manager and all tokens. Manager is not thread-safe:
+ * every compilation uses its own manager
+ */
+class SourceManager {
+private:
+    /**
+     * @brief Structure of registered source file
+     */
+    struct SourceFile {
+        std::string name;                                                       /**< Name of the file */
+        std::string_view text;                                                  /**< Source code (view into the buffer owned by caller) */
+    };
+
+    std::deque<SourceFile> files;                                               /**< Registered files (indexed by file ID) */
+
+public:
+    /**
+     * @brief Method for registering source file
+     *
+     * @param name Name of the file
+     * @param text Source code
+     * @param file_id ID of the registered file
+     *
+     * @return 'true' if file is registered and 'false' if limit of file IDs is reached or source is too big for 32-bit token offsets
+     */
+    bool add_file(std::string name, std::string_view text, uint16_t& file_id);
+
+    /**
+     * @brief Method for getting name of the file
+     *
+     * @param file_id ID of the file
+     *
+     * @return Name of the file
+     */
+    const std::string& get_file_name(uint16_t file_id) const {
+        return files[file_id].name;
+    }
+
+    /**
+     * @brief Method for getting source code of the file
+     *
+     * @param file_id ID of the file
+     *
+     * @return Source code
+     */
+    std::string_view get_source(uint16_t file_id) const {
+        return files[file_id].text;
+    }
+
+    /**
+     * @brief Method for getting text of the token
+     *
+     * @param token Token
+     *
+     * @return Token text (view into the source)
+     */
+    std::string_view get_text(const Token& token) const {
+        return files[token.file_id].text.substr(token.offset, token.length);
+    }
+};
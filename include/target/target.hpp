@@ -0,0 +1,76 @@
+/**
+ * @file target.hpp
+ *
+ * @brief Header file for defining the target selection
+ */
+
+#pragma once
+#include "../optimizer/optimizer.hpp"
+#include <llvm/Target/TargetMachine.h>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Structure for describing the target of compilation
+ */
+struct TargetConfig {
+    std::string triple;                         /**< Target triple (empty for the host triple) */
+    std::string cpu = "generic";                /**< Target CPU ('native' for the host CPU) */
+    std::string features;                       /**< Target features as comma separated list (for example '+avx2,-fma') */
+    bool native = false;                        /**< Flag 'tune CPU and features for the host' */
+};
+
+/**
+ * @brief Function for getting the host triple
+ *
+ * This function returns $TOPAZ_TRIPLE if it is set. Otherwise returns triple of the compiler process from LLVM host APIs
+ *
+ * @return Host triple
+ */
+std::string get_host_triple();
+
+/**
+ * @brief Function for resolving target config
+ *
+ * This function fills empty triple with the host triple. If CPU is 'native' or config is native, then CPU and features are filled
+ * from host detection (user features are appended after detected ones, so they can override them)
+ *
+ * @param config Target config for resolving
+ */
+void resolve_target_config(TargetConfig& config);
+
+/**
+ * @brief Function for creating target machine
+ *
+ * This function looking up target by triple of resolved config and creates target machine for it
+ *
+ * @param config Resolved target config
+ * @param level Optimization level
+ * @param error Error message in case of fail
+ *
+ * @return Target machine or nullptr in case of fail
+ */
+std::unique_ptr<llvm::TargetMachine> create_target_machine(const TargetConfig& config, OptLevel level, std::string& error);
+
+/**
+ * @brief Function for acquiring target machine
+ *
+ * This function takes target machine with the same config and optimization level from the pool of released target machines
+ * (for example, prewarmed by the compile server). If pool does not have such target machine, then new one is created
+ *
+ * @param config Resolved target config
+ * @param level Optimization level
+ * @param error Error message in case of fail
+ *
+ * @return Target machine or nullptr in case of fail
+ */
+std::unique_ptr<llvm::TargetMachine> acquire_target_machine(const TargetConfig& config, OptLevel level, std::string& error);
+
+/**
+ * @brief Function for releasing target machine into the pool
+ *
+ * @param config Resolved target config of target machine
+ * @param level Optimization level of target machine
+ * @param target_machine Target machine (not used by caller anymore)
+ */
+void release_target_machine(const TargetConfig& config, OptLevel level, std::unique_ptr<llvm::TargetMachine> target_machine);
@@ -0,0 +1,235 @@
+/**
+ * @file cache.cpp
+ *
+ * @brief cache.hpp implementation
+ */
+
+#include "../../include/cache/cache.hpp"
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/Endian.h>
+#include <llvm/Support/xxhash.h>
+#include <llvm/ADT/SmallString.h>
+#include <cstring>
+#include <cstdlib>
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <netdb.h>
+#endif
+
+std::unique_ptr<llvm::MemoryBuffer> LocalCacheBackend::lookup(const std::string& key) {
+    auto buffer = llvm::MemoryBuffer::getFile(dir + '/' + key, false, false);
+    if (!buffer) {
+        return nullptr;
+    }
+    return std::move(*buffer);
+}
+
+void LocalCacheBackend::store(const std::string& key, llvm::StringRef data) {
+    if (llvm::sys::fs::create_directories(dir)) {
+        return;
+    }
+    int fd = -1;
+    llvm::SmallString<128> temp_path;
+    if (llvm::sys::fs::createUniqueFile(dir + '/' + key + ".tmp-%%%%%%", fd, temp_path)) {
+        return;
+    }
+    llvm::raw_fd_ostream os(fd, true);
+    os << data;
+    os.close();
+    if (os.has_error()) {
+        os.clear_error();
+        llvm::sys::fs::remove(temp_path);
+        return;
+    }
+    if (llvm::sys::fs::rename(temp_path, dir + '/' + key)) {
+        llvm::sys::fs::remove(temp_path);
+    }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> HttpCacheBackend::lookup(const std::string& key) {
+    std::string body;
+    if (request("GET", key, "", body) != 200) {
+        return nullptr;
+    }
+    return llvm::MemoryBuffer::getMemBufferCopy(body, key);
+}
+
+void HttpCacheBackend::store(const std::string& key, llvm::StringRef data) {
+    std::string body;
+    request("PUT", key, data, body);
+}
+
+int HttpCacheBackend::request(const std::string& method, const std::string& key, llvm::StringRef body, std::string& response_body) {
+    #if defined(_WIN32)
+    return -1;
+    #else
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addrs = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addrs) != 0) {
+        return -1;
+    }
+    int sock = -1;
+    for (addrinfo *addr = addrs; addr != nullptr; addr = addr->ai_next) {
+        sock = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+        if (sock < 0) {
+            continue;
+        }
+        timeval timeout{ .tv_sec = 5, .tv_usec = 0 };
+        setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+        if (connect(sock, addr->ai_addr, addr->ai_addrlen) == 0) {
+            break;
+        }
+        close(sock);
+        sock = -1;
+    }
+    freeaddrinfo(addrs);
+    if (sock < 0) {
+        return -1;
+    }
+
+    // HTTP/1.0 response is never chunked, so its body is either 'Content-Length' bytes or everything until the connection is closed
+    std::string req = method + ' ' + prefix + '/' + key + " HTTP/1.0\r\n";
+    req += "Host: " + host + "\r\n";
+    req += "Connection: close\r\n";
+    req += "Content-Type: application/octet-stream\r\n";
+    req += "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n";
+    req += body.str();
+    size_t sent = 0;
+    while (sent < req.size()) {
+        ssize_t n = send(sock, req.data() + sent, req.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) {
+            close(sock);
+            return -1;
+        }
+        sent += n;
+    }
+
+    std::string response;
+    char buf[16384];
+    while (1) {
+        ssize_t n = recv(sock, buf, sizeof(buf), 0);
+        if (n < 0) {
+            close(sock);
+            return -1;
+        }
+        if (n == 0) {
+            break;
+        }
+        response.append(buf, n);
+    }
+    close(sock);
+
+    size_t headers_end = response.find("\r\n\r\n");
+    if (response.compare(0, 5, "HTTP/") != 0 || headers_end == std::string::npos) {
+        return -1;
+    }
+    size_t status_pos = response.find(' ');
+    if (status_pos == std::string::npos || status_pos > headers_end) {
+        return -1;
+    }
+    int status = std::atoi(response.c_str() + status_pos + 1);
+
+    response_body = response.substr(headers_end + 4);
+    llvm::StringRef headers = llvm::StringRef(response).take_front(headers_end);
+    size_t length_pos = headers.find_insensitive("\r\ncontent-length:");
+    if (length_pos != llvm::StringRef::npos) {
+        size_t length = std::strtoull(headers.data() + length_pos + 17, nullptr, 10);
+        if (response_body.size() < length) {
+            return -1;
+        }
+        response_body.resize(length);
+    }
+    return status;
+    #endif
+}
+
+std::unique_ptr<CacheBackend> create_cache_backend(const std::string& spec, std::string& error) {
+    llvm::StringRef rest(spec);
+    if (!rest.consume_front("http://")) {
+        if (spec.empty()) {
+            error = "Cache directory is not specified";
+            return nullptr;
+        }
+        return std::make_unique<LocalCacheBackend>(spec);
+    }
+
+    #if defined(_WIN32)
+    error = "HTTP cache backend is unsupported on Windows";
+    return nullptr;
+    #else
+    auto [authority, path] = rest.split('/');
+    auto [host, port_str] = authority.split(':');
+    uint16_t port = 80;
+    if (!port_str.empty() && port_str.getAsInteger(10, port)) {
+        error = "Invalid port in cache URL '" + spec + "'";
+        return nullptr;
+    }
+    if (host.empty()) {
+        error = "Host is not specified in cache URL '" + spec + "'";
+        return nullptr;
+    }
+    std::string prefix = path.empty() ? "" : '/' + path.rtrim('/').str();
+    return std::make_unique<HttpCacheBackend>(host.str(), port, prefix);
+    #endif
+}
+
+std::string pack_cache_entry(uint8_t flags, llvm::ArrayRef<llvm::StringRef> objects) {
+    std::string payload;
+    if (objects.size() == 1) {
+        flags &= ~CACHE_ENTRY_PARTITIONED;
+        payload = objects[0].str();
+    }
+    else {
+        flags |= CACHE_ENTRY_PARTITIONED;
+        for (llvm::StringRef object : objects) {
+            char size[8];
+            llvm::support::endian::write64le(size, object.size());
+            payload.append(size, sizeof(size));
+            payload += object;
+        }
+    }
+    std::string entry(CACHE_ENTRY_HEADER_SIZE, '\0');
+    entry[0] = static_cast<char>(flags);
+    llvm::support::endian::write64le(&entry[1], payload.size());
+    llvm::support::endian::write64le(&entry[9], llvm::xxHash64(payload));
+    entry += payload;
+    return entry;
+}
+
+bool unpack_cache_entry(llvm::StringRef entry, uint8_t& flags, std::vector<llvm::StringRef>& objects) {
+    // truncated or damaged entry (for example, broken response of HTTP cache) is a miss
+    if (entry.size() < CACHE_ENTRY_HEADER_SIZE) {
+        return false;
+    }
+    flags = entry[0];
+    uint64_t payload_size = llvm::support::endian::read64le(entry.data() + 1);
+    uint64_t payload_hash = llvm::support::endian::read64le(entry.data() + 9);
+    entry = entry.drop_front(CACHE_ENTRY_HEADER_SIZE);
+    if (entry.size() != payload_size || llvm::xxHash64(entry) != payload_hash) {
+        return false;
+    }
+    if (!(flags & CACHE_ENTRY_PARTITIONED)) {
+        objects.push_back(entry);
+        return true;
+    }
+    while (!entry.empty()) {
+        if (entry.size() < 8) {
+            return false;
+        }
+        uint64_t size = llvm::support::endian::read64le(entry.data());
+        entry = entry.drop_front(8);
+        if (size > entry.size()) {
+            return false;
+        }
+        objects.push_back(entry.take_front(size));
+        entry = entry.drop_front(size);
+    }
+    return !objects.empty();
+}
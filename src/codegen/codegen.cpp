@@ -21,16 +21,40 @@
 #include <llvm/IR/Type.h>
 #include <cstddef>
 #include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/BinaryFormat/Dwarf.h>
+#include <llvm/Support/Path.h>
 #include <sstream>
 #include <vector>
 
 void CodeGenerator::generate() {
+    if (debug_info) {
+        create_debug_info();
+    }
     for (const AST::StmtPtr& stmt : stmts) {
         generate_stmt(*stmt);
     }
+    if (di_builder != nullptr) {
+        di_builder->finalize();
+    }
+}
+
+void CodeGenerator::create_debug_info() {
+    di_builder = std::make_unique<llvm::DIBuilder>(*module);
+    di_file = di_builder->createFile(llvm::sys::path::filename(file_name), llvm::sys::path::parent_path(file_name));
+    di_builder->createCompileUnit(llvm::dwarf::DW_LANG_C, di_file, "topazc", optimized, "", 0, "", llvm::DICompileUnit::LineTablesOnly, 0, true, true);
+    module->addModuleFlag(llvm::Module::Warning, "Debug Info Version", llvm::DEBUG_METADATA_VERSION);
+    module->addModuleFlag(llvm::Module::Max, "Dwarf Version", 4);
+}
+
+void CodeGenerator::set_debug_location(uint32_t line) {
+    if (di_subprogram != nullptr) {
+        builder.SetCurrentDebugLocation(llvm::DILocation::get(*context, line, 0, di_subprogram));
+    }
 }
 
 void CodeGenerator::generate_stmt(AST::Stmt& stmt) {
+    set_debug_location(stmt.line);
     if (auto vds = dynamic_cast<AST::VarDeclStmt*>(&stmt)) {
         generate_var_decl_stmt(*vds);
     }
@@ -65,7 +89,7 @@ void CodeGenerator::generate_var_decl_stmt(AST::VarDeclStmt& vds) {
         var = new llvm::GlobalVariable(*module, type, vds.type.is_const, llvm::GlobalValue::ExternalLinkage, llvm::dyn_cast<llvm::Constant>(val), vds.name);
     }
     else {
-        var = builder.CreateAlloca(type, nullptr, vds.name + ".alloca");
+        var = builder.CreateAlloca(type, nullptr, llvm::Twine(vds.name) + ".alloca");
         builder.CreateStore(val, var);
     }
     variables.top().emplace(vds.name, var);
@@ -90,6 +114,7 @@ void CodeGenerator::generate_var_asgn_stmt(AST::VarAsgnStmt& vas) {
 }
 
 void CodeGenerator::generate_func_decl_stmt(AST::FuncDeclStmt& fds) {
+    llvm::TimeTraceScope scope("CodeGenFunction", fds.name);
     llvm::Type *ret_type = type_to_llvm(fds.ret_type);
     std::vector<llvm::Type*> args;
     size_t args_count = fds.args.size();
@@ -99,8 +124,15 @@ void CodeGenerator::generate_func_decl_stmt(AST::FuncDeclStmt& fds) {
     llvm::FunctionType *func_type = llvm::FunctionType::get(ret_type, args, false);
     llvm::Function *func = llvm::Function::Create(func_type, llvm::GlobalValue::ExternalLinkage, fds.name, *module);
     
-    llvm::BasicBlock *entry = llvm::BasicBlock::Create(context, "entry", func);
+    llvm::BasicBlock *entry = llvm::BasicBlock::Create(*context, "entry", func);
     builder.SetInsertPoint(entry);
+    if (di_builder != nullptr) {
+        llvm::DISubroutineType *di_type = di_builder->createSubroutineType(di_builder->getOrCreateTypeArray({}));
+        di_subprogram = di_builder->createFunction(di_file, fds.name, fds.name, di_file, fds.line, di_type, fds.line,
+                                                   llvm::DINode::FlagPrototyped, llvm::DISubprogram::SPFlagDefinition);
+        func->setSubprogram(di_subprogram);
+        set_debug_location(fds.line);
+    }
     
     variables.push({});
     functions.emplace(fds.name, func);
@@ -117,16 +149,24 @@ void CodeGenerator::generate_func_decl_stmt(AST::FuncDeclStmt& fds) {
         generate_stmt(*fds.block[i]);
     }
     variables.pop();
+    di_subprogram = nullptr;
+    builder.SetCurrentDebugLocation(llvm::DebugLoc());
 }
 
 void CodeGenerator::generate_func_call_stmt(AST::FuncCallStmt& fcs) {
-    llvm::Function *func = functions.at(fcs.name);
+    auto func_it = functions.find(fcs.name);
+    if (func_it == functions.end()) {
+        std::stringstream ss;
+        ss << "Function \033[0m'" << fcs.name << "'\033[31m does not exists";
+        throw_exception(SUB_CODEGEN, ss.str(), fcs.line, file_name);
+    }
+    llvm::Function *func = func_it->second;
     std::vector<llvm::Value*> args;
     for (auto& arg : fcs.args) {
         args.push_back(generate_expr(*arg));
     }
 
-    builder.CreateCall(func, args, fcs.name + ".call");
+    builder.CreateCall(func, args, llvm::Twine(fcs.name) + ".call");
 }
 
 void CodeGenerator::generate_return_stmt(AST::ReturnStmt& rs) {
@@ -141,9 +181,9 @@ void CodeGenerator::generate_return_stmt(AST::ReturnStmt& rs) {
 void CodeGenerator::generate_if_else_stmt(AST::IfElseStmt& ies) {
     llvm::Function *parent = builder.GetInsertBlock()->getParent();
     llvm::Value *cond_val = generate_expr(*ies.cond);
-    llvm::BasicBlock *then_bb = llvm::BasicBlock::Create(context, "then", parent);
-    llvm::BasicBlock *else_bb = llvm::BasicBlock::Create(context, "else", parent);
-    llvm::BasicBlock *merge_bb = llvm::BasicBlock::Create(context, "merge", parent);
+    llvm::BasicBlock *then_bb = llvm::BasicBlock::Create(*context, "then", parent);
+    llvm::BasicBlock *else_bb = llvm::BasicBlock::Create(*context, "else", parent);
+    llvm::BasicBlock *merge_bb = llvm::BasicBlock::Create(*context, "merge", parent);
 
     builder.CreateCondBr(cond_val, then_bb, else_bb ? else_bb : merge_bb);
 
@@ -193,25 +233,25 @@ llvm::Value *CodeGenerator::generate_expr(AST::Expr& expr) {
 }
 
 llvm::Value *CodeGenerator::generate_literal_expr(AST::Literal& lit) {
-    auto& value = lit.value.value;
+    auto& value = lit.value->value;
 
-    switch (lit.type.type) {
+    switch (lit.kind) {
         case AST::TYPE_CHAR:
-            return llvm::ConstantInt::get(type_to_llvm(lit.type), llvm::APInt(8, std::get<char8_t>(value)));
+            return llvm::ConstantInt::get(type_to_llvm(lit.get_type()), llvm::APInt(8, std::get<char8_t>(value)));
         case AST::TYPE_SHORT:
-            return llvm::ConstantInt::get(type_to_llvm(lit.type), llvm::APInt(16, std::get<int16_t>(value)));
+            return llvm::ConstantInt::get(type_to_llvm(lit.get_type()), llvm::APInt(16, std::get<int16_t>(value)));
         case AST::TYPE_INT:
-            return llvm::ConstantInt::get(type_to_llvm(lit.type), llvm::APInt(32, std::get<int32_t>(value)));
+            return llvm::ConstantInt::get(type_to_llvm(lit.get_type()), llvm::APInt(32, std::get<int32_t>(value)));
         case AST::TYPE_LONG:
-            return llvm::ConstantInt::get(type_to_llvm(lit.type), llvm::APInt(64, std::get<int64_t>(value)));
+            return llvm::ConstantInt::get(type_to_llvm(lit.get_type()), llvm::APInt(64, std::get<int64_t>(value)));
         case AST::TYPE_FLOAT:
-            return llvm::ConstantFP::get(type_to_llvm(lit.type), llvm::APFloat(std::get<float_t>(value)));
+            return llvm::ConstantFP::get(type_to_llvm(lit.get_type()), llvm::APFloat(std::get<float>(value)));
         case AST::TYPE_DOUBLE:
-            return llvm::ConstantFP::get(type_to_llvm(lit.type), llvm::APFloat(std::get<double_t>(value)));
+            return llvm::ConstantFP::get(type_to_llvm(lit.get_type()), llvm::APFloat(std::get<double>(value)));
         case AST::TYPE_BOOL:
-            return llvm::ConstantInt::get(type_to_llvm(lit.type), llvm::APInt(1, std::get<bool>(value)));
+            return llvm::ConstantInt::get(type_to_llvm(lit.get_type()), llvm::APInt(1, std::get<bool>(value)));
         case AST::TYPE_STRING_LIT: {
-                llvm::Constant *str_const = llvm::ConstantDataArray::getString(context, std::get<std::string>(value), true);
+                llvm::Constant *str_const = llvm::ConstantDataArray::getString(*context, std::get<std::string_view>(value), true);
                 llvm::GlobalVariable *str_var = new llvm::GlobalVariable(*module, str_const->getType(), true, llvm::GlobalValue::PrivateLinkage, str_const, "string.lit");
                 return str_var;
             }
@@ -226,65 +266,65 @@ llvm::Value *CodeGenerator::generate_binary_expr(AST::BinaryExpr& be) {
     llvm::Value *right = generate_expr(*be.right_expr);
     llvm::Type *right_type = right->getType();
 
-    switch (be.op.type) {
-        case TOK_OP_PLUS:
+    switch (be.op) {
+        case AST::BIN_OP_PLUS:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFAdd(left, right, "fadd.tmp");
             }
             return builder.CreateAdd(left, right, "add.tmp");
-        case TOK_OP_MINUS:
+        case AST::BIN_OP_MINUS:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFSub(left, right, "fsub.tmp");
             }
             return builder.CreateSub(left, right, "sub.tmp");
-        case TOK_OP_MULT:
+        case AST::BIN_OP_MULT:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFMul(left, right, "fmul.tmp");
             }
             return builder.CreateMul(left, right, "mul.tmp");
-        case TOK_OP_DIV:
+        case AST::BIN_OP_DIV:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFDiv(left, right, "fdiv.tmp");
             }
             return builder.CreateSDiv(left, right, "div.tmp");
-        case TOK_OP_MODULO:
+        case AST::BIN_OP_MODULO:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFRem(left, right, "frem.tmp");
             }
             return builder.CreateSRem(left, right, "rem.tmp");
-        case TOK_OP_EQ_EQ:
+        case AST::BIN_OP_EQ_EQ:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFCmpUEQ(left, right, "feq.tmp");
             }
             return builder.CreateICmpEQ(left, right, "eq.tmp");
-        case TOK_OP_NOT_EQ_EQ:
+        case AST::BIN_OP_NOT_EQ_EQ:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateNeg(builder.CreateFCmpUEQ(left, right, "feq.tmp"), "fnoteq.tmp");
             }
             return builder.CreateNeg(builder.CreateICmpEQ(left, right, "eq.tmp"), "noteq.tmp");
-        case TOK_OP_GT:
+        case AST::BIN_OP_GT:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFCmpUGT(left, right, "fgt.tmp");
             }
             return builder.CreateICmpSGT(left, right, "gt.tmp");
-        case TOK_OP_GT_EQ:
+        case AST::BIN_OP_GT_EQ:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFCmpUGE(left, right, "fge.tmp");
             }
             return builder.CreateICmpSGE(left, right, "ge.tmp");
-        case TOK_OP_LS:
+        case AST::BIN_OP_LS:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFCmpULT(left, right, "flt.tmp");
             }
             return builder.CreateICmpSLT(left, right, "lt.tmp");
-        case TOK_OP_LS_EQ:
+        case AST::BIN_OP_LS_EQ:
             if (left_type->isFloatingPointTy() || right_type->isFloatingPointTy()) {
                 return builder.CreateFCmpULE(left, right, "fle.tmp");
             }
             return builder.CreateICmpSLE(left, right, "le.tmp");
-        case TOK_OP_L_AND:
+        case AST::BIN_OP_L_AND:
             return builder.CreateLogicalAnd(left, right, "land.tmp");
-        case TOK_OP_L_OR:
+        case AST::BIN_OP_L_OR:
             return builder.CreateLogicalAnd(left, right, "lor.tmp");
         default:
             throw_exception(SUB_CODEGEN, "An unsupported binary operator was encountered during compilation. Please check your Topaz compiler version and fix the problematic section of the code", be.line, file_name);
@@ -294,13 +334,13 @@ llvm::Value *CodeGenerator::generate_binary_expr(AST::BinaryExpr& be) {
 llvm::Value *CodeGenerator::generate_unary_expr(AST::UnaryExpr& ue) {
     llvm::Value* value = generate_expr(*ue.expr);
     
-    switch (ue.op.type) {
-        case TOK_OP_MINUS:
+    switch (ue.op) {
+        case AST::UN_OP_MINUS:
             if (value->getType()->isFloatingPointTy()) {
                 return builder.CreateFNeg(value, "neg.tmp");
             }
             return builder.CreateNeg(value, "neg.tmp");
-        case TOK_OP_L_NOT:
+        case AST::UN_OP_L_NOT:
             if (value->getType()->isFloatingPointTy()) {
                 return builder.CreateFCmpOEQ(value, builder.getInt32(0), "lnot.tmp");
             }
@@ -322,7 +362,7 @@ llvm::Value *CodeGenerator::generate_var_expr(AST::VarExpr& ve) {
             else if (auto local = llvm::dyn_cast<llvm::AllocaInst>(vars_it->second)) {
                 type = local->getAllocatedType();
             }
-            return vars_it->second;
+            return builder.CreateLoad(type, vars_it->second, llvm::Twine(ve.name) + ".load");
         }
         vars.pop();
     }
@@ -332,33 +372,39 @@ llvm::Value *CodeGenerator::generate_var_expr(AST::VarExpr& ve) {
 }
 
 llvm::Value *CodeGenerator::generate_func_call_expr(AST::FuncCallExpr& fce) {
-    llvm::Function *func = functions.at(fce.name);
+    auto func_it = functions.find(fce.name);
+    if (func_it == functions.end()) {
+        std::stringstream ss;
+        ss << "Function \033[0m'" << fce.name << "'\033[31m does not exists";
+        throw_exception(SUB_CODEGEN, ss.str(), fce.line, file_name);
+    }
+    llvm::Function *func = func_it->second;
     std::vector<llvm::Value*> args;
     for (auto& arg : fce.args) {
         args.push_back(generate_expr(*arg));
     }
 
-    return builder.CreateCall(func, args, fce.name + ".call");
+    return builder.CreateCall(func, args, llvm::Twine(fce.name) + ".call");
 }
 
 llvm::Type *CodeGenerator::type_to_llvm(AST::Type type) {
     switch (type.type) {
         case AST::TYPE_CHAR:
-            return llvm::Type::getInt8Ty(context);
+            return llvm::Type::getInt8Ty(*context);
         case AST::TYPE_SHORT:
-            return llvm::Type::getInt16Ty(context);
+            return llvm::Type::getInt16Ty(*context);
         case AST::TYPE_INT:
-            return llvm::Type::getInt32Ty(context);
+            return llvm::Type::getInt32Ty(*context);
         case AST::TYPE_LONG:
-            return llvm::Type::getInt64Ty(context);
+            return llvm::Type::getInt64Ty(*context);
         case AST::TYPE_FLOAT:
-            return llvm::Type::getFloatTy(context);
+            return llvm::Type::getFloatTy(*context);
         case AST::TYPE_DOUBLE:
-            return llvm::Type::getDoubleTy(context);
+            return llvm::Type::getDoubleTy(*context);
         case AST::TYPE_BOOL:
-            return llvm::Type::getInt1Ty(context);
+            return llvm::Type::getInt1Ty(*context);
         case AST::TYPE_NOTH:
-            return llvm::Type::getVoidTy(context);
+            return llvm::Type::getVoidTy(*context);
         default:
             throw_exception(SUB_CODEGEN, "Unsupported type", -1, file_name);
     }
@@ -0,0 +1,822 @@
+/**
+ * @file driver.cpp
+ *
+ * @brief driver.hpp implementation
+ */
+
+#include "../../include/semantic/semantic.hpp"
+#include "../../include/codegen/codegen.hpp"
+#include "../../include/parser/parser.hpp"
+#include "../../include/driver/driver.hpp"
+#include "../../include/memory/memory.hpp"
+#include "../../include/lexer/lexer.hpp"
+#include "../../include/exception/exception.hpp"
+#include "../../include/jit/jit.hpp"
+#include <llvm/Transforms/Utils/SplitModule.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/IR/LegacyPassManager.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/Support/TimeProfiler.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Support/SHA256.h>
+#include <llvm/Support/Program.h>
+#include <llvm/Support/Path.h>
+#include <llvm/Config/llvm-config.h>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Support/Threading.h>
+#include <llvm/TargetParser/Triple.h>
+#include <llvm/IR/Module.h>
+#include <filesystem>
+#include <optional>
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(_WIN32)
+static const char *obj_ext = ".obj";
+static const char *exe_ext = ".exe";
+#else
+static const char *obj_ext = ".o";
+static const char *exe_ext = "";
+#endif
+
+#if !defined(TOPAZC_VERSION)
+#define TOPAZC_VERSION "unknown"
+#endif
+
+/**
+ * @brief Function for emitting object file of module
+ *
+ * @param target_machine Target machine
+ * @param module Module
+ * @param dest Output stream of the object
+ * @param error Error message in case of fail
+ *
+ * @return 'true' if object is emitted and 'false' otherwise
+ */
+static bool emit_object(llvm::TargetMachine& target_machine, llvm::Module& module, llvm::raw_pwrite_stream& dest, std::string& error) {
+    llvm::TimeTraceScope scope("EmitObject");
+    llvm::legacy::PassManager pass;
+
+    auto fileType = static_cast<llvm::CodeGenFileType>(1); // 1 = Object file
+    if (target_machine.addPassesToEmitFile(pass, dest, nullptr, fileType)) {
+        error = "TargetMachine can't emit a file of this type";
+        return false;
+    }
+    pass.run(module);
+    return true;
+}
+
+bool parse_options(int argc, const char *argv[], CompilerOptions& options) {
+    bool cache_disabled = false;
+    const char *env_cache = std::getenv("TOPAZC_CACHE");
+    if (env_cache && *env_cache) {
+        options.cache = env_cache;
+    }
+    const char *env_server = std::getenv("TOPAZC_SERVER");
+    if (env_server && *env_server) {
+        options.connect_socket = env_server;
+    }
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--tokens") == 0) {
+            options.print_tokens = true;
+        }
+        else if (strcmp(argv[i], "--ir") == 0) {
+            options.print_ir = true;
+        }
+        else if (strcmp(argv[i], "--obj") == 0) {
+            options.output_is_object = true;
+        }
+        else if (strcmp(argv[i], "--path") == 0) {
+            if (i == argc - 1) {
+                std::cerr << "\033[31mCompilation error: After \033[0m'--path'\033[31m option should be followed by the path to the output file!\033[0m\n";
+                return false;
+            }
+            options.output_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--lld") == 0) {
+            options.linker_kind = LINKER_LLD;
+        }
+        else if (strncmp(argv[i], "--mcpu=", 7) == 0) {
+            options.target_config.cpu = argv[i] + 7;
+        }
+        else if (strncmp(argv[i], "--mattr=", 8) == 0) {
+            options.target_config.features = argv[i] + 8;
+        }
+        else if (strncmp(argv[i], "--march=", 8) == 0) {
+            if (strcmp(argv[i] + 8, "native") == 0) {
+                options.target_config.native = true;
+            }
+            else {
+                options.target_config.cpu = argv[i] + 8;
+            }
+        }
+        else if (strncmp(argv[i], "--lto=", 6) == 0) {
+            if (strcmp(argv[i] + 6, "thin") == 0) {
+                options.thin_lto = true;
+            }
+            else if (strcmp(argv[i] + 6, "none") == 0) {
+                options.thin_lto = false;
+            }
+            else {
+                std::cerr << "\033[31mCompilation error: Unknown LTO mode \033[0m'" << argv[i] + 6 << "'\033[31m. Supported modes: thin, none\033[0m\n";
+                return false;
+            }
+        }
+        else if (strcmp(argv[i], "--profile-generate") == 0 || strncmp(argv[i], "--profile-generate=", 19) == 0) {
+            std::string dir = argv[i][18] == '=' ? argv[i] + 19 : "";
+            options.profile.kind = PROFILE_GENERATE;
+            options.profile.path = dir.empty() ? "default_%m.profraw" : dir + "/default_%m.profraw";
+        }
+        else if (strncmp(argv[i], "--profile-use=", 14) == 0) {
+            options.profile.kind = PROFILE_USE;
+            options.profile.path = argv[i] + 14;
+        }
+        else if (strncmp(argv[i], "--profile-sample-use=", 21) == 0) {
+            options.profile.kind = PROFILE_SAMPLE_USE;
+            options.profile.path = argv[i] + 21;
+            options.profile.debug_info = true;
+        }
+        else if (strcmp(argv[i], "-g") == 0) {
+            options.profile.debug_info = true;
+        }
+        else if (strncmp(argv[i], "--cache=", 8) == 0) {
+            options.cache = argv[i] + 8;
+        }
+        else if (strcmp(argv[i], "--mem-report") == 0) {
+            options.mem_report = true;
+        }
+        else if (strcmp(argv[i], "--time-trace") == 0) {
+            options.time_trace = true;
+        }
+        else if (strncmp(argv[i], "--time-trace-file=", 18) == 0) {
+            options.time_trace = true;
+            options.time_trace_path = argv[i] + 18;
+        }
+        else if (strncmp(argv[i], "--time-trace-granularity=", 25) == 0) {
+            int granularity = std::atoi(argv[i] + 25);
+            if (granularity < 0 || (granularity == 0 && strcmp(argv[i] + 25, "0") != 0)) {
+                std::cerr << "\033[31mCompilation error: Invalid time trace granularity \033[0m'" << argv[i] + 25 << "'\n";
+                return false;
+            }
+            options.time_trace_granularity = granularity;
+        }
+        else if (strncmp(argv[i], "--server=", 9) == 0) {
+            options.server_socket = argv[i] + 9;
+        }
+        else if (strncmp(argv[i], "--connect=", 10) == 0) {
+            options.connect_socket = argv[i] + 10;
+        }
+        else if (strcmp(argv[i], "--run") == 0) {
+            options.run = true;
+        }
+        else if (strcmp(argv[i], "--") == 0) {
+            options.run_args.assign(argv + i + 1, argv + argc);
+            break;
+        }
+        else if (strcmp(argv[i], "--no-cache") == 0) {
+            options.cache = "";
+            cache_disabled = true;
+        }
+        else if (strncmp(argv[i], "-j", 2) == 0) {
+            const char *jobs = argv[i] + 2;
+            if (*jobs == '\0') {
+                if (i == argc - 1) {
+                    std::cerr << "\033[31mCompilation error: After \033[0m'-j'\033[31m option should be followed by the count of jobs!\033[0m\n";
+                    return false;
+                }
+                jobs = argv[++i];
+            }
+            int count = std::atoi(jobs);
+            if (count <= 0) {
+                std::cerr << "\033[31mCompilation error: Invalid count of jobs \033[0m'" << jobs << "'\033[0m\n";
+                return false;
+            }
+            options.jobs = count;
+        }
+        else if (strncmp(argv[i], "--codegen-threads=", 18) == 0) {
+            int count = std::atoi(argv[i] + 18);
+            if (count <= 0) {
+                std::cerr << "\033[31mCompilation error: Invalid count of code generation threads \033[0m'" << argv[i] + 18 << "'\n";
+                return false;
+            }
+            options.codegen_threads = count;
+        }
+        else if (strncmp(argv[i], "-O", 2) == 0) {
+            if (!parse_opt_level(argv[i], options.opt_level)) {
+                std::cerr << "\033[31mCompilation error: Unknown optimization level \033[0m'" << argv[i] << "'\033[31m. Supported levels: -O0, -O1, -O2, -O3, -Os, -Oz\033[0m\n";
+                return false;
+            }
+        }
+        else if (argv[i][0] == '-') {
+            std::cerr << "\033[31mCompilation error: Unknown option \033[0m'" << argv[i] << "'\n";
+            return false;
+        }
+        else {
+            options.sources.push_back(argv[i]);
+        }
+    }
+
+    if (cache_disabled) {
+        options.cache = "";
+    }
+    else if (options.run && options.cache.empty()) {
+        llvm::SmallString<128> cache_dir;
+        if (llvm::sys::path::cache_directory(cache_dir)) {
+            llvm::sys::path::append(cache_dir, "topazc");
+            options.cache = cache_dir.str().str();
+        }
+    }
+    if (options.run && options.output_is_object) {
+        std::cerr << "\033[31mCompilation error: Option \033[0m'--run'\033[31m can't be used with \033[0m'--obj'\n";
+        return false;
+    }
+    if (options.run && options.profile.kind == PROFILE_GENERATE) {
+        std::cerr << "\033[31mCompilation error: Option \033[0m'--run'\033[31m can't be used with \033[0m'--profile-generate'\n";
+        return false;
+    }
+    if (options.run && options.thin_lto) {
+        std::cerr << "\033[31mCompilation error: Option \033[0m'--run'\033[31m can't be used with \033[0m'--lto=thin'\n";
+        return false;
+    }
+    // O0 pipeline applies only instrumentation, so profile would be silently ignored
+    if (options.opt_level == OPT_O0 && (options.profile.kind == PROFILE_USE || options.profile.kind == PROFILE_SAMPLE_USE)) {
+        std::cerr << "\033[31mCompilation error: Option \033[0m'" << (options.profile.kind == PROFILE_USE ? "--profile-use" : "--profile-sample-use")
+                  << "'\033[31m requires optimization level \033[0m'-O1'\033[31m or higher\033[0m\n";
+        return false;
+    }
+    if (options.codegen_threads > 1 && (options.run || options.output_is_object || options.thin_lto)) {
+        std::cerr << "\033[31mCompilation error: Option \033[0m'--codegen-threads'\033[31m can't be used with \033[0m'"
+                  << (options.run ? "--run" : options.output_is_object ? "--obj" : "--lto=thin") << "'\n";
+        return false;
+    }
+    if (options.sources.empty() && options.server_socket.empty()) {
+        std::cerr << "\033[33mUsage: topazc \"path/to/src.tp\" [\"path/to/other.tp\" ...] [options]\033[0m\n";
+        return false;
+    }
+    return true;
+}
+
+int Driver::run() {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+    resolve_target_config(options.target_config);
+
+    if (!options.cache.empty()) {
+        std::string error;
+        cache = create_cache_backend(options.cache, error);
+        if (cache == nullptr) {
+            std::cerr << "\033[31mCompilation error: " << error << "\033[0m\n";
+            return 1;
+        }
+        compiler_id = std::string(TOPAZC_VERSION) + '/' + LLVM_VERSION_STRING;
+        std::string executable = llvm::sys::fs::getMainExecutable(nullptr, nullptr);
+        llvm::sys::fs::file_status status;
+        if (!executable.empty() && !llvm::sys::fs::status(executable, status)) {
+            compiler_id += '/' + std::to_string(status.getSize()) + '/' + std::to_string(status.getLastModificationTime().time_since_epoch().count());
+        }
+    }
+
+    if (options.profile.kind == PROFILE_USE || options.profile.kind == PROFILE_SAMPLE_USE) {
+        auto profile_or_err = llvm::MemoryBuffer::getFile(options.profile.path);
+        if (!profile_or_err) {
+            std::cerr << "\033[31mCompilation error: Error openning profile '" << options.profile.path << "': " << profile_or_err.getError().message() << "\033[0m\n";
+            return 1;
+        }
+        if (cache != nullptr) {
+            profile_id = llvm::toHex(llvm::SHA256::hash(llvm::arrayRefFromStringRef((*profile_or_err)->getBuffer())), true);
+        }
+    }
+
+    if (!options.time_trace) {
+        return build();
+    }
+
+    llvm::timeTraceProfilerInitialize(options.time_trace_granularity, "topazc");
+    int exit_code = build();
+    std::string trace_base = options.output_path.empty() ? std::filesystem::absolute(options.sources[0]).string() : options.output_path;
+    if (llvm::Error err = llvm::timeTraceProfilerWrite(options.time_trace_path, remove_extension(trace_base))) {
+        std::cerr << "\033[31mCompilation error: Failed to write time trace: " << llvm::toString(std::move(err)) << "\033[0m\n";
+        exit_code = exit_code == 0 ? 1 : exit_code;
+    }
+    llvm::timeTraceProfilerCleanup();
+    return exit_code;
+}
+
+int Driver::build() {
+
+    std::string executable_path = options.output_path.empty() ? std::filesystem::absolute(options.sources[0]).string() : options.output_path;
+    executable_path = remove_extension(executable_path) + exe_ext;
+
+    size_t sources_count = options.sources.size();
+    std::vector<std::string> object_paths(sources_count);
+    for (size_t i = 0; i < sources_count; i++) {
+        if (sources_count == 1) {
+            object_paths[i] = executable_path + obj_ext;
+        }
+        else {
+            object_paths[i] = remove_extension(std::filesystem::absolute(options.sources[i]).string()) + obj_ext;
+        }
+    }
+
+    bool emit_to_memory = options.run || (options.linker_kind == LINKER_LLD && !options.output_is_object);
+    std::vector<CompileResult> results(sources_count);
+    // memory of compiler structures is measured as heap growth, so memory report needs sequential compilation
+    if (options.jobs == 1 || sources_count == 1 || options.mem_report) {
+        for (size_t i = 0; i < sources_count; i++) {
+            results[i] = compile_file(options.sources[i], object_paths[i], emit_to_memory);
+        }
+    }
+    else {
+        llvm::DefaultThreadPool pool(llvm::hardware_concurrency(options.jobs));
+        for (size_t i = 0; i < sources_count; i++) {
+            pool.async([this, i, &results, &object_paths, emit_to_memory]() {
+                if (options.time_trace) {
+                    llvm::timeTraceProfilerInitialize(options.time_trace_granularity, "topazc");
+                }
+                results[i] = compile_file(options.sources[i], object_paths[i], emit_to_memory);
+                if (options.time_trace) {
+                    llvm::timeTraceProfilerFinishThread();
+                }
+            });
+        }
+        pool.wait();
+    }
+
+    bool success = true;
+    size_t main_count = 0;
+    for (CompileResult& result : results) {
+        std::cout << result.output;
+        std::cerr << result.diagnostics;
+        if (!result.success) {
+            std::cerr << "\033[31mCompilation error: " << result.error << "\033[0m\n";
+            success = false;
+        }
+        main_count += result.has_main;
+    }
+    if (!success) {
+        return 1;
+    }
+
+    if (options.output_is_object) {
+        for (CompileResult& result : results) {
+            for (std::string& object_path : result.object_paths) {
+                std::cout << "COMPILING SUCCESS. Built object: " << object_path << '\n';
+            }
+        }
+        return 0;
+    }
+
+    if (main_count != 1) {
+        if (main_count == 0) {
+            std::cerr << "\033[31mCompilation error: Program does not have entry point 'main'\033[0m" << '\n';
+        }
+        else {
+            std::cerr << "\033[31mCompilation error: Program has more than one entry point 'main'\033[0m" << '\n';
+        }
+        return 1;
+    }
+
+    if (options.run) {
+        return run_jit(results);
+    }
+
+    Linker linker(options.linker_kind, llvm::Triple(options.target_config.triple), executable_path);
+    if (options.thin_lto) {
+        linker.enable_thin_lto(options.jobs > 1 ? options.jobs : 0, options.opt_level);
+        if (options.profile.kind == PROFILE_SAMPLE_USE) {
+            linker.set_lto_sample_profile(options.profile.path);
+        }
+    }
+    if (options.profile.kind == PROFILE_GENERATE) {
+        linker.enable_profile_runtime();
+    }
+    for (CompileResult& result : results) {
+        for (std::unique_ptr<llvm::MemoryBuffer>& object : result.objects) {
+            linker.add_object_buffer(std::move(object));
+        }
+        for (std::string& object_path : result.object_paths) {
+            linker.add_object_file(object_path);
+        }
+    }
+    std::string link_error;
+    bool linked;
+    {
+        llvm::TimeTraceScope scope("Link");
+        linked = linker.link(link_error);
+    }
+    if (!linked) {
+        std::cerr << "\033[31mCompilation error: " << link_error << "\033[0m\n";
+        return 1;
+    }
+
+    std::cout << "COMPILING SUCCESS. Built executable: " << executable_path << '\n';
+
+    for (CompileResult& result : results) {
+        for (std::string& object_path : result.object_paths) {
+            if (std::remove(object_path.c_str()) != 0) {
+                std::cerr << "\033[31mCompilation error: Warning: Failed to remove object file: " << object_path << "\033[0m\n";
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+Driver::CompileResult Driver::compile_file(const std::string& source_path, const std::string& object_path, bool emit_to_memory) {
+    llvm::TimeTraceScope source_scope("Source", source_path);
+    CompileResult result;
+    result.object_path = object_path;
+    llvm::raw_string_ostream output(result.output);
+
+    std::unique_ptr<llvm::MemoryBuffer> source;
+    {
+        llvm::TimeTraceScope scope("ReadSource");
+        auto source_or_err = llvm::MemoryBuffer::getFile(source_path, false, false);
+        if (!source_or_err) {
+            result.error = "Error openning file '" + source_path + "': " + source_or_err.getError().message();
+            return result;
+        }
+        source = std::move(*source_or_err);
+    }
+    std::filesystem::path file_path = std::filesystem::absolute(source_path);
+    llvm::StringRef content = source->getBuffer();
+
+    std::string cache_key;
+    bool use_cache = cache != nullptr && !options.print_tokens && !options.print_ir && !options.mem_report;
+    if (use_cache) {
+        llvm::TimeTraceScope scope("CacheLookup");
+        cache_key = get_cache_key(file_path.string(), content);
+        result.cache_key = cache_key;
+        std::unique_ptr<llvm::MemoryBuffer> entry = cache->lookup(cache_key);
+        uint8_t flags;
+        std::vector<llvm::StringRef> objects;
+        if (entry != nullptr && unpack_cache_entry(entry->getBuffer(), flags, objects)) {
+            result.has_main = flags & CACHE_ENTRY_HAS_MAIN;
+            result.success = write_objects(result, objects, emit_to_memory);
+            return result;
+        }
+    }
+
+    // phases report errors into the diagnostics engine and recover; unrecoverable error unwinds to the phase boundary
+    DiagnosticEngine diagnostics;
+    auto run_phase = [&diagnostics](auto&& phase) {
+        try {
+            phase();
+        }
+        catch (const CompilationError&) {
+        }
+        return !diagnostics.has_errors();
+    };
+    auto report_diagnostics = [&diagnostics, &result, &source_path]() {
+        std::ostringstream diagnostics_output;
+        diagnostics.print(diagnostics_output);
+        result.diagnostics = diagnostics_output.str();
+        size_t errors_count = diagnostics.get_errors_count();
+        result.error = std::to_string(errors_count) + (errors_count == 1 ? " error" : " errors") + " in '" + source_path + "'";
+    };
+
+    std::optional<MemoryReport> mem_report;
+    MemorySample structure_start;
+    if (options.mem_report) {
+        mem_report.emplace(file_path.string());
+        mem_report->record_phase("Start");
+    }
+
+    SourceManager sources;
+    uint16_t file_id;
+    if (!sources.add_file(file_path.string(), std::string_view(content.data(), content.size()), file_id)) {
+        result.error = "Source file '" + source_path + "' is too big";
+        return result;
+    }
+
+    // jobs which are not used by other sources tokenize chunks of big source in parallel
+    uint32_t lex_threads = std::max<uint32_t>(1, options.jobs / options.sources.size());
+    // tokens are kept in vector only if they are printed, measured or tokenized in parallel, otherwise parser pulls them from lexer on demand
+    bool stream_tokens = !options.print_tokens && !mem_report && (lex_threads == 1 || content.size() < Lexer::PARALLEL_THRESHOLD);
+    Lexer lexer(sources, file_id);
+    std::vector<Token> tokens;
+    size_t tokens_memory = 0;
+    if (!stream_tokens) {
+        run_phase([&]() {
+            llvm::TimeTraceScope scope("Lex");
+            tokens = lexer.tokenize(lex_threads);
+        });
+        if (options.print_tokens) {
+            output << "\033[1m\033[32mTokens:\033[0m\n";
+            for (Token& token : tokens) {
+                output << token.to_str(sources.get_text(token)) << '\n';
+            }
+        }
+        tokens_memory = get_tokens_memory(tokens);
+        if (mem_report) {
+            mem_report->record_phase("Lex");
+            mem_report->record_structure("Tokens (" + std::to_string(tokens.size()) + ")", tokens_memory);
+            structure_start = sample_memory();
+        }
+    }
+
+    // errors of lexer and parser are reported together, because parser continues after skipped invalid tokens
+    ASTContext ast_context;
+    std::vector<AST::StmtPtr> stmts;
+    bool parsed = run_phase([&]() {
+        llvm::TimeTraceScope scope(stream_tokens ? "Lex+Parse" : "Parse");
+        if (stream_tokens) {
+            Parser parser(lexer, sources, ast_context);
+            stmts = parser.parse();
+        }
+        else {
+            Parser parser(std::move(tokens), lexer, sources, ast_context);
+            stmts = parser.parse();
+        }
+    });
+    if (!parsed) {
+        report_diagnostics();
+        return result;
+    }
+    if (mem_report) {
+        MemorySample sample = mem_report->record_phase("Parse");
+        // tokens are moved into parser and freed with it, so they are excluded from heap before parsing
+        structure_start.heap -= std::min(structure_start.heap, tokens_memory);
+        mem_report->record_structure("AST (" + std::to_string(stmts.size()) + " top-level statements)", get_heap_growth(structure_start, sample));
+        mem_report->record_structure("AST arena (used by nodes and names)", ast_context.get_allocated_bytes());
+        structure_start = sample;
+    }
+
+    bool analyzed = run_phase([&]() {
+        llvm::TimeTraceScope scope("Semantic");
+        SemanticAnalyzer semantic(stmts, file_path.string());
+        semantic.analyze();
+        if (mem_report) {
+            mem_report->record_structure("Semantic tables", get_heap_growth(structure_start, sample_memory()));
+        }
+    });
+    if (!analyzed) {
+        report_diagnostics();
+        return result;
+    }
+    if (mem_report) {
+        structure_start = mem_report->record_phase("Semantic");
+    }
+
+    CodeGenerator codegen(stmts, file_path.string(), options.profile.debug_info, options.opt_level != OPT_O0);
+    bool generated = run_phase([&]() {
+        llvm::TimeTraceScope scope("CodeGen");
+        codegen.generate();
+    });
+    if (!generated) {
+        report_diagnostics();
+        return result;
+    }
+    if (mem_report) {
+        mem_report->record_structure("LLVM module", get_heap_growth(structure_start, mem_report->record_phase("CodeGen")));
+    }
+    if (options.print_ir) {
+        if (options.print_tokens) {
+            output << '\n';
+        }
+        output << "\033[1m\033[32mLLVM IR:\033[0m\n";
+        codegen.print_ir(output);
+    }
+
+    std::unique_ptr<llvm::Module> module = codegen.get_module();
+    result.has_main = module->getFunction("main") != nullptr;
+    module->setTargetTriple(llvm::Triple(options.target_config.triple));
+
+    std::unique_ptr<llvm::TargetMachine> target_machine = acquire_target_machine(options.target_config, options.opt_level, result.error);
+    if (!target_machine) {
+        return result;
+    }
+    module->setDataLayout(target_machine->createDataLayout());
+
+    // target CPU and features are kept in functions, so the ThinLTO backend generates code for the same target.
+    // Sample profile loader processes only functions marked with 'use-sample-profile'
+    for (llvm::Function& func : *module) {
+        if (func.isDeclaration()) {
+            continue;
+        }
+        func.addFnAttr("target-cpu", options.target_config.cpu);
+        if (!options.target_config.features.empty()) {
+            func.addFnAttr("target-features", options.target_config.features);
+        }
+        if (options.profile.kind == PROFILE_SAMPLE_USE) {
+            func.addFnAttr("use-sample-profile");
+        }
+    }
+
+    uint32_t partitions_count = 0;
+    if (options.codegen_threads > 1) {
+        for (llvm::Function& func : *module) {
+            partitions_count += !func.isDeclaration();
+        }
+        partitions_count = std::min(partitions_count, options.codegen_threads);
+    }
+
+    std::vector<llvm::SmallVector<char, 0>> object_buffers(1);
+    if (partitions_count > 1) {
+        release_target_machine(options.target_config, options.opt_level, std::move(target_machine));
+        object_buffers.clear();
+        if (!emit_partitions(*module, partitions_count, object_buffers, result.error)) {
+            return result;
+        }
+        if (mem_report) {
+            mem_report->record_phase("Optimize+Emit");
+        }
+    }
+    else {
+        llvm::raw_svector_ostream dest(object_buffers[0]);
+        {
+            llvm::TimeTraceScope scope("Optimize");
+            Optimizer optimizer(target_machine.get(), options.opt_level, options.profile);
+            optimizer.optimize(*module, options.thin_lto ? &dest : nullptr);
+        }
+        if (mem_report) {
+            mem_report->record_phase("Optimize");
+        }
+
+        if (options.run) {
+            if (mem_report) {
+                mem_report->print(output);
+            }
+            release_target_machine(options.target_config, options.opt_level, std::move(target_machine));
+            result.module = std::move(module);
+            result.context = codegen.get_context();
+            result.success = true;
+            return result;
+        }
+
+        if (!options.thin_lto && !emit_object(*target_machine, *module, dest, result.error)) {
+            return result;
+        }
+        release_target_machine(options.target_config, options.opt_level, std::move(target_machine));
+        if (mem_report) {
+            mem_report->record_phase("Emit");
+        }
+    }
+    if (mem_report) {
+        mem_report->print(output);
+    }
+
+    std::vector<llvm::StringRef> objects;
+    for (llvm::SmallVector<char, 0>& object_buffer : object_buffers) {
+        objects.emplace_back(object_buffer.data(), object_buffer.size());
+    }
+    if (use_cache) {
+        llvm::TimeTraceScope scope("CacheStore");
+        cache->store(cache_key, pack_cache_entry(result.has_main ? CACHE_ENTRY_HAS_MAIN : 0, objects));
+    }
+
+    result.success = write_objects(result, objects, emit_to_memory);
+    return result;
+}
+
+bool Driver::emit_partitions(llvm::Module& module, uint32_t count, std::vector<llvm::SmallVector<char, 0>>& objects, std::string& error) {
+    // partitions share LLVM context of the module, so they are moved into their own contexts through bitcode before running in parallel
+    std::vector<llvm::SmallVector<char, 0>> bitcodes;
+    {
+        llvm::TimeTraceScope scope("SplitModule");
+        llvm::SplitModule(module, count, [&bitcodes](std::unique_ptr<llvm::Module> partition) {
+            llvm::raw_svector_ostream bitcode(bitcodes.emplace_back());
+            llvm::WriteBitcodeToFile(*partition, bitcode);
+        });
+    }
+
+    objects.resize(bitcodes.size());
+    std::vector<std::string> errors(bitcodes.size());
+    // sources may already be compiled on the '-j' pool, so partitions of every source get only its share of hardware threads
+    uint32_t concurrent_sources = options.mem_report ? 1 : std::min<uint32_t>(options.jobs, options.sources.size());
+    uint32_t threads = std::max<uint32_t>(1, llvm::hardware_concurrency().compute_thread_count() / concurrent_sources);
+    llvm::DefaultThreadPool pool(llvm::hardware_concurrency(std::min(count, threads)));
+    for (size_t i = 0; i < bitcodes.size(); i++) {
+        pool.async([this, i, &bitcodes, &objects, &errors]() {
+            if (options.time_trace) {
+                llvm::timeTraceProfilerInitialize(options.time_trace_granularity, "topazc");
+            }
+            emit_partition(llvm::StringRef(bitcodes[i].data(), bitcodes[i].size()), objects[i], errors[i]);
+            if (options.time_trace) {
+                llvm::timeTraceProfilerFinishThread();
+            }
+        });
+    }
+    pool.wait();
+
+    for (std::string& partition_error : errors) {
+        if (!partition_error.empty()) {
+            error = partition_error;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Driver::emit_partition(llvm::StringRef bitcode, llvm::SmallVector<char, 0>& object, std::string& error) {
+    llvm::TimeTraceScope scope("Partition");
+    llvm::LLVMContext context;
+    llvm::Expected<std::unique_ptr<llvm::Module>> module_or_err = llvm::parseBitcodeFile(llvm::MemoryBufferRef(bitcode, "partition"), context);
+    if (!module_or_err) {
+        error = "Failed to load code generation partition: " + llvm::toString(module_or_err.takeError());
+        return false;
+    }
+    std::unique_ptr<llvm::Module> module = std::move(*module_or_err);
+
+    std::unique_ptr<llvm::TargetMachine> target_machine = acquire_target_machine(options.target_config, options.opt_level, error);
+    if (!target_machine) {
+        return false;
+    }
+    {
+        llvm::TimeTraceScope scope("Optimize");
+        Optimizer optimizer(target_machine.get(), options.opt_level, options.profile);
+        optimizer.optimize(*module);
+    }
+    llvm::raw_svector_ostream dest(object);
+    bool emitted = emit_object(*target_machine, *module, dest, error);
+    release_target_machine(options.target_config, options.opt_level, std::move(target_machine));
+    return emitted;
+}
+
+int Driver::run_jit(std::vector<CompileResult>& results) {
+    llvm::TimeTraceScope scope("JIT");
+    JIT jit;
+    std::string error;
+    if (!jit.init(options.target_config, options.opt_level, cache.get(), error)) {
+        std::cerr << "\033[31mCompilation error: " << error << "\033[0m\n";
+        return 1;
+    }
+    for (CompileResult& result : results) {
+        bool added = true;
+        if (result.module != nullptr) {
+            added = jit.add_module(std::move(result.module), std::move(result.context), result.cache_key, error);
+        }
+        for (size_t i = 0; added && i < result.objects.size(); i++) {
+            added = jit.add_object(std::move(result.objects[i]), error);
+        }
+        if (!added) {
+            std::cerr << "\033[31mCompilation error: " << error << "\033[0m\n";
+            return 1;
+        }
+    }
+
+    std::cout.flush();
+    int exit_code = 0;
+    if (!jit.run_main(options.sources[0], options.run_args, exit_code, error)) {
+        std::cerr << "\033[31mCompilation error: " << error << "\033[0m\n";
+        return 1;
+    }
+    return exit_code;
+}
+
+std::string Driver::get_cache_key(llvm::StringRef source_path, llvm::StringRef source) {
+    llvm::SHA256 hasher;
+    auto update = [&hasher](llvm::StringRef value) {
+        hasher.update(value);
+        hasher.update(llvm::StringRef("\0", 1));
+    };
+    update(compiler_id);
+    update(options.target_config.triple);
+    update(options.target_config.cpu);
+    update(options.target_config.features);
+    update(std::to_string(options.opt_level));
+    update(options.run ? "jit" : options.thin_lto ? "thin-lto-bitcode" : "object/" + std::to_string(options.codegen_threads));
+    update(std::to_string(options.profile.kind) + (options.profile.debug_info ? "/g" : ""));
+    update(options.profile.kind == PROFILE_GENERATE ? options.profile.path : profile_id);
+    // module name and debug info embed the absolute path, so equal sources at different paths get different objects
+    update(source_path);
+    update(source);
+    return llvm::toHex(hasher.final(), true);
+}
+
+bool Driver::write_objects(CompileResult& result, llvm::ArrayRef<llvm::StringRef> objects, bool emit_to_memory) {
+    for (size_t i = 0; i < objects.size(); i++) {
+        std::string object_path = i == 0 ? result.object_path : remove_extension(result.object_path) + ".part" + std::to_string(i) + obj_ext;
+        if (emit_to_memory) {
+            result.objects.push_back(llvm::MemoryBuffer::getMemBufferCopy(objects[i], object_path));
+            continue;
+        }
+        std::error_code ec;
+        llvm::raw_fd_ostream dest(object_path, ec, llvm::sys::fs::OF_None);
+        if (ec) {
+            result.error = "Could not open file '" + object_path + "': " + ec.message();
+            return false;
+        }
+        dest << objects[i];
+        result.object_paths.push_back(object_path);
+    }
+    return true;
+}
+
+std::string Driver::remove_extension(std::string path) {
+    if (path.find('.') != std::string::npos) {
+        for (int i = path.size() - 1; path[i] != '.'; i--) {
+            path.pop_back();
+        }
+        path.pop_back();
+    }
+    return path;
+}
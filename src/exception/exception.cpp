@@ -8,6 +8,8 @@
 #include <iostream>
 #include <cstdlib>
 
+static thread_local DiagnosticEngine *current_engine = nullptr;     /**< Diagnostics engine of the current thread */
+
 /**
  * @brief Function for converting passed subsystem type into string
  *
@@ -21,15 +23,49 @@ std::string convert_subsystem_type_to_string(SubsystemType type) {
             return "lexer";
         case SUB_PARSER:
             return "parser";
-        case SUB_SEMANTIC:    
+        case SUB_SEMANTIC:
             return "semantic";
         case SUB_CODEGEN:
             return "codegen";
     }
 }
 
+DiagnosticEngine::DiagnosticEngine(uint32_t limit) : error_limit(limit), previous(current_engine) {
+    current_engine = this;
+}
+
+DiagnosticEngine::~DiagnosticEngine() {
+    current_engine = previous;
+}
+
+bool DiagnosticEngine::report(Diagnostic diagnostic) {
+    diagnostics.push_back(std::move(diagnostic));
+    return error_limit != 0 && diagnostics.size() >= error_limit;
+}
+
+void DiagnosticEngine::print(std::ostream& os) const {
+    for (const Diagnostic& diagnostic : diagnostics) {
+        print_diagnostic(os, diagnostic);
+    }
+    if (error_limit != 0 && diagnostics.size() >= error_limit) {
+        os << "\033[31mToo many errors, compilation of the file is stopped\033[0m\n";
+    }
+}
+
+DiagnosticEngine *DiagnosticEngine::get_current() {
+    return current_engine;
+}
+
+void print_diagnostic(std::ostream& os, const Diagnostic& diagnostic) {
+    os << "\033[31mSubsystem " << convert_subsystem_type_to_string(diagnostic.subsystem) << " was panicked\n";
+    os << "Compilation error at:\033[0m " << diagnostic.file_name << ':' << diagnostic.line << "\n\033[31m" << diagnostic.msg << "\033[0m\n";
+}
+
 void throw_exception(SubsystemType type, std::string msg, uint32_t line, std::string file_name) {
-    std::cerr << "\033[31mSubsystem " << convert_subsystem_type_to_string(type) << " was panicked\n";
-    std::cerr << "Compilation error at:\033[0m " << file_name << ':' << line << "\n\033[31m" << msg << "\033[0m\n";
-    exit(1);
-}
\ No newline at end of file
+    Diagnostic diagnostic { type, std::move(msg), line, std::move(file_name) };
+    if (current_engine == nullptr) {
+        print_diagnostic(std::cerr, diagnostic);
+        throw CompilationError(true);
+    }
+    throw CompilationError(current_engine->report(std::move(diagnostic)));
+}
@@ -0,0 +1,115 @@
+/**
+ * @file jit.cpp
+ *
+ * @brief jit.hpp implementation
+ */
+
+#include "../../include/jit/jit.hpp"
+#include <llvm/ExecutionEngine/Orc/TargetProcess/TargetExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/JITTargetMachineBuilder.h>
+#include <llvm/ExecutionEngine/Orc/ThreadSafeModule.h>
+#include <llvm/ExecutionEngine/Orc/ExecutionUtils.h>
+#include <llvm/ExecutionEngine/Orc/CompileUtils.h>
+#include <llvm/TargetParser/Triple.h>
+#include <llvm/Support/Error.h>
+
+void JITObjectCache::add_key(const std::string& module_id, const std::string& key) {
+    std::lock_guard<std::mutex> lock(keys_mutex);
+    keys[module_id] = key;
+}
+
+void JITObjectCache::notifyObjectCompiled(const llvm::Module *module, llvm::MemoryBufferRef object) {
+    std::string key;
+    {
+        std::lock_guard<std::mutex> lock(keys_mutex);
+        auto key_it = keys.find(module->getModuleIdentifier());
+        if (key_it == keys.end()) {
+            return;
+        }
+        key = key_it->second;
+    }
+    llvm::Function *main_func = module->getFunction("main");
+    bool has_main = main_func != nullptr && !main_func->isDeclaration();
+    std::string entry(1, static_cast<char>(has_main ? CACHE_ENTRY_HAS_MAIN : 0));
+    entry += object.getBuffer();
+    backend->store(key, entry);
+}
+
+std::unique_ptr<llvm::MemoryBuffer> JITObjectCache::getObject(const llvm::Module *module) {
+    return nullptr;
+}
+
+bool JIT::init(const TargetConfig& config, OptLevel level, CacheBackend *cache, std::string& error) {
+    llvm::orc::JITTargetMachineBuilder jtmb((llvm::Triple(config.triple)));
+    jtmb.setCPU(config.cpu);
+    llvm::SmallVector<llvm::StringRef> features;
+    llvm::StringRef(config.features).split(features, ',', -1, false);
+    jtmb.addFeatures(std::vector<std::string>(features.begin(), features.end()));
+    jtmb.setCodeGenOptLevel(Optimizer::get_codegen_opt_level(level));
+
+    if (cache != nullptr) {
+        object_cache = std::make_unique<JITObjectCache>(cache);
+    }
+    JITObjectCache *oc = object_cache.get();
+    auto jit_or_err = llvm::orc::LLJITBuilder()
+        .setJITTargetMachineBuilder(std::move(jtmb))
+        .setCompileFunctionCreator([oc](llvm::orc::JITTargetMachineBuilder jtmb) -> llvm::Expected<std::unique_ptr<llvm::orc::IRCompileLayer::IRCompiler>> {
+            auto target_machine = jtmb.createTargetMachine();
+            if (!target_machine) {
+                return target_machine.takeError();
+            }
+            return std::make_unique<llvm::orc::TMOwningSimpleCompiler>(std::move(*target_machine), oc);
+        })
+        .create();
+    if (!jit_or_err) {
+        error = llvm::toString(jit_or_err.takeError());
+        return false;
+    }
+    jit = std::move(*jit_or_err);
+
+    auto generator = llvm::orc::DynamicLibrarySearchGenerator::GetForCurrentProcess(jit->getDataLayout().getGlobalPrefix());
+    if (!generator) {
+        error = llvm::toString(generator.takeError());
+        return false;
+    }
+    jit->getMainJITDylib().addGenerator(std::move(*generator));
+    return true;
+}
+
+bool JIT::add_module(std::unique_ptr<llvm::Module> module, std::unique_ptr<llvm::LLVMContext> context, const std::string& cache_key, std::string& error) {
+    if (object_cache != nullptr && !cache_key.empty()) {
+        object_cache->add_key(module->getModuleIdentifier(), cache_key);
+    }
+    if (llvm::Error err = jit->addIRModule(llvm::orc::ThreadSafeModule(std::move(module), std::move(context)))) {
+        error = llvm::toString(std::move(err));
+        return false;
+    }
+    return true;
+}
+
+bool JIT::add_object(std::unique_ptr<llvm::MemoryBuffer> object, std::string& error) {
+    if (llvm::Error err = jit->addObjectFile(std::move(object))) {
+        error = llvm::toString(std::move(err));
+        return false;
+    }
+    return true;
+}
+
+bool JIT::run_main(const std::string& program_name, const std::vector<std::string>& args, int& exit_code, std::string& error) {
+    if (llvm::Error err = jit->initialize(jit->getMainJITDylib())) {
+        error = llvm::toString(std::move(err));
+        return false;
+    }
+    auto main_sym = jit->lookup("main");
+    if (!main_sym) {
+        error = llvm::toString(main_sym.takeError());
+        return false;
+    }
+    auto *main_func = main_sym->toPtr<int (*)(int, char *[])>();
+    exit_code = llvm::orc::runAsMain(main_func, args, llvm::StringRef(program_name));
+    if (llvm::Error err = jit->deinitialize(jit->getMainJITDylib())) {
+        error = llvm::toString(std::move(err));
+        return false;
+    }
+    return true;
+}
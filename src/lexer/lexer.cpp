@@ -6,267 +6,532 @@
 
 #include "../../include/exception/exception.hpp"
 #include "../../include/lexer/lexer.hpp"
+#include "../../include/lexer/scan.hpp"
 #include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
 #include <sstream>
+#include <thread>
 
-std::vector<Token> Lexer::tokenize() {
-    std::vector<Token> tokens;
-
-    while (pos < source_len) {
-        const char c = peek();
-        if (c == ' ' || c == '\n') {
-            advance();
-        }
-        else if (c == '/') {
-            if (peek(1) == '/') {
-                skip_comments();
+/**
+ * @brief Function for recognizing keyword
+ *
+ * Keyword is selected by length and first character of identifier, so only one string comparison is done
+ *
+ * @param id Identifier text
+ *
+ * @return Type of keyword token, boolean literal for 'true' and 'false' or identifier otherwise
+ */
+static constexpr TokenType get_keyword_type(std::string_view id) {
+    switch (id.size()) {
+        case 2:
+            return id == "if" ? TOK_IF : TOK_ID;
+        case 3:
+            switch (id[0]) {
+                case 'i':
+                    return id == "int" ? TOK_INT : TOK_ID;
+                case 'l':
+                    return id == "let" ? TOK_LET : TOK_ID;
+                case 'f':
+                    return id == "fun" ? TOK_FUN : id == "for" ? TOK_FOR : TOK_ID;
+                default:
+                    return TOK_ID;
             }
-            else {
-                tokens.push_back(tokenize_op());
+        case 4:
+            switch (id[0]) {
+                case 'b':
+                    return id == "bool" ? TOK_BOOL : TOK_ID;
+                case 'c':
+                    return id == "char" ? TOK_CHAR : TOK_ID;
+                case 'l':
+                    return id == "long" ? TOK_LONG : TOK_ID;
+                case 'n':
+                    return id == "noth" ? TOK_NOTH : TOK_ID;
+                case 'e':
+                    return id == "else" ? TOK_ELSE : TOK_ID;
+                case 't':
+                    return id == "true" ? TOK_BOOLEAN_LIT : TOK_ID;
+                default:
+                    return TOK_ID;
+            }
+        case 5:
+            switch (id[0]) {
+                case 's':
+                    return id == "short" ? TOK_SHORT : TOK_ID;
+                case 'f':
+                    return id == "float" ? TOK_FLOAT : id == "false" ? TOK_BOOLEAN_LIT : TOK_ID;
+                case 'w':
+                    return id == "while" ? TOK_WHILE : TOK_ID;
+                case 'c':
+                    return id == "const" ? TOK_CONST : TOK_ID;
+                default:
+                    return TOK_ID;
             }
+        case 6:
+            switch (id[0]) {
+                case 'd':
+                    return id == "double" ? TOK_DOUBLE : TOK_ID;
+                case 'r':
+                    return id == "return" ? TOK_RETURN : TOK_ID;
+                default:
+                    return TOK_ID;
+            }
+        default:
+            return TOK_ID;
+    }
+}
+
+static_assert(get_keyword_type("bool") == TOK_BOOL && get_keyword_type("char") == TOK_CHAR && get_keyword_type("short") == TOK_SHORT &&
+              get_keyword_type("int") == TOK_INT && get_keyword_type("long") == TOK_LONG && get_keyword_type("float") == TOK_FLOAT &&
+              get_keyword_type("double") == TOK_DOUBLE && get_keyword_type("noth") == TOK_NOTH && get_keyword_type("let") == TOK_LET &&
+              get_keyword_type("fun") == TOK_FUN && get_keyword_type("if") == TOK_IF && get_keyword_type("else") == TOK_ELSE &&
+              get_keyword_type("for") == TOK_FOR && get_keyword_type("while") == TOK_WHILE && get_keyword_type("const") == TOK_CONST &&
+              get_keyword_type("return") == TOK_RETURN && get_keyword_type("true") == TOK_BOOLEAN_LIT && get_keyword_type("false") == TOK_BOOLEAN_LIT,
+              "Every keyword must be recognized");
+static_assert(get_keyword_type("in") == TOK_ID && get_keyword_type("fort") == TOK_ID && get_keyword_type("f") == TOK_ID && get_keyword_type("") == TOK_ID,
+              "Identifiers must not be recognized as keywords");
+
+std::vector<Token> Lexer::tokenize(uint32_t threads) {
+    std::vector<Token> tokens;
+    Token token;
+
+    if (threads > 1 && pos == 0 && source_len >= PARALLEL_THRESHOLD && tokenize_parallel(threads, tokens)) {
+        pos = source_len;
+        return tokens;
+    }
+
+    while (next_token(token)) {
+        tokens.push_back(token);
+    }
+
+    return tokens;
+}
+
+/**
+ * @brief Function for getting start offset of chunk of source code
+ *
+ * Chunk starts after the first newline at or after the approximate offset, so every thread finds borders of own chunk without
+ * scanning of previous chunks. Newline is assumed to be outside of literals: if it is inside literal, then the previous chunk ends
+ * with unterminated literal, has errors and source is tokenized sequentially
+ *
+ * @param source Source code
+ * @param index Index of chunk (index equal to count gives end of the last chunk)
+ * @param count Count of chunks
+ *
+ * @return Start offset of chunk
+ */
+static uint32_t get_chunk_begin(std::string_view source, uint32_t index, uint32_t count) {
+    if (index == 0) {
+        return 0;
+    }
+    else if (index == count) {
+        return source.size();
+    }
+    const char *end = source.data() + source.size();
+    const char *newline = scan::find_line_end(source.data() + source.size() / count * index, end);
+    return newline == end ? source.size() : newline - source.data() + 1;
+}
+
+bool Lexer::tokenize_parallel(uint32_t threads, std::vector<Token>& tokens) {
+    uint32_t count = std::min<size_t>(threads, source_len / MIN_CHUNK_SIZE);
+    if (count < 2) {
+        return false;
+    }
+
+    std::vector<std::vector<Token>> chunk_tokens(count);
+    std::vector<std::vector<NumberValue>> chunk_values(count);
+    std::vector<uint32_t> chunk_newlines(count);
+    std::vector<uint8_t> chunk_failed(count);
+    // every thread collects errors into its own diagnostics engine, errors are reported by sequential tokenizing
+    auto tokenize_chunk = [this, count, &chunk_tokens, &chunk_values, &chunk_newlines, &chunk_failed](uint32_t i) {
+        DiagnosticEngine diagnostics;
+        try {
+            Lexer lexer(*this, get_chunk_begin(source, i, count), get_chunk_begin(source, i + 1, count), 1);
+            chunk_tokens[i] = lexer.tokenize();
+            chunk_values[i] = std::move(lexer.number_values);
+            chunk_newlines[i] = lexer.line - 1;
         }
-        else if (isalpha(c)) {
-            tokens.push_back(tokenize_id());
+        catch (const CompilationError&) {
+            // error is already collected by diagnostics engine
         }
-        else if (isdigit(c)) {
-            tokens.push_back(tokenize_number_lit());
+        chunk_failed[i] = diagnostics.has_errors();
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(count - 1);
+    for (uint32_t i = 1; i < count; i++) {
+        workers.emplace_back(tokenize_chunk, i);
+    }
+    tokenize_chunk(0);
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    size_t tokens_count = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        if (chunk_failed[i]) {
+            return false;
         }
-        else if (c == '\"') {
-            tokens.push_back(tokenize_string_lit());
+        tokens_count += chunk_tokens[i].size();
+    }
+    tokens.reserve(tokens_count);
+    uint32_t lines_base = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        // lines and indexes of number values are local to chunk, so they are shifted by lines and values of previous chunks
+        const uint32_t values_base = number_values.size();
+        for (Token token : chunk_tokens[i]) {
+            token.line += lines_base;
+            if (token.type >= TOK_SHORT_LIT && token.type <= TOK_DOUBLE_LIT) {
+                token.value_index += values_base;
+            }
+            tokens.push_back(token);
         }
-        else if (c == '\'') {
-            tokens.push_back(tokenize_character_lit());
+        number_values.insert(number_values.end(), chunk_values[i].begin(), chunk_values[i].end());
+        lines_base += chunk_newlines[i];
+    }
+    return true;
+}
+
+bool Lexer::next_token(Token& token) {
+    while (pos < source_len) {
+        try {
+            const char c = source[pos];
+            if (c == ' ' || c == '\n') {
+                skip_whitespaces();
+                continue;
+            }
+            else if (c == '/') {
+                if (pos + 1 < source_len && source[pos + 1] == '/') {
+                    skip_comments();
+                    continue;
+                }
+                token = tokenize_op();
+            }
+            else if (isalpha(c)) {
+                token = tokenize_id();
+            }
+            else if (isdigit(c)) {
+                token = tokenize_number_lit();
+            }
+            else if (c == '\"') {
+                token = tokenize_string_lit();
+            }
+            else if (c == '\'') {
+                token = tokenize_character_lit();
+            }
+            else {
+                token = tokenize_op();
+            }
+            return true;
         }
-        else {
-            tokens.push_back(tokenize_op());
+        catch (const CompilationError& error) {
+            if (error.is_fatal()) {
+                throw;
+            }
+            recover();
         }
     }
 
-    return tokens;
+    return false;
+}
+
+void Lexer::reset() {
+    pos = 0;
+    line = 1;
+    line_start = 0;
+    number_values.clear();
 }
 
 Token Lexer::tokenize_id() {
-    std::string value;
+    uint32_t start = pos;
     uint32_t tmp_l = line;
-    uint32_t tmp_c = column;
+    uint32_t tmp_c = get_column();
 
-    while (pos < source_len && (isalpha(peek()) || isdigit(peek()) || peek() == '_')) {
-        value += advance();
-    }
+    pos = scan::find_id_end(source.data() + pos + 1, source.data() + source_len) - source.data();
+    std::string_view value = source.substr(start, pos - start);
 
-    if (keywords.find(value) != keywords.end()) {
-        return Token(keywords[value], value, tmp_l, tmp_c, file_name);
-    }
-    else if (value == "true" || value == "false") {
-        return Token(TOK_BOOLEAN_LIT, value, tmp_l, tmp_c, file_name);
-    }
-    return Token(TOK_ID, value, tmp_l, tmp_c, file_name);
+    return make_token(get_keyword_type(value), start, tmp_l, tmp_c);
 }
 
 Token Lexer::tokenize_number_lit() {
-    std::string value;
+    uint32_t start = pos;
     uint32_t tmp_l = line;
-    uint32_t tmp_c = column;
+    uint32_t tmp_c = get_column();
     bool has_dot = false;
 
-    while (pos < source_len && (isdigit(peek()) || peek() == '.' || peek() == '_')) {
-        if (peek() == '_') {
-            advance();
-            continue;
+    while (true) {
+        pos = scan::find_digits_end(source.data() + pos, source.data() + source_len) - source.data();
+        if (pos == source_len || source[pos] != '.') {
+            break;
         }
-        else if (peek() == '.') {
-            if (has_dot) {
-                throw_exception(SUB_LEXER, "Invalid number literal: twice dot", line, file_name);
-            }
-            else if (pos < source_len && peek(1) == '_') {
-                throw_exception(SUB_LEXER, "Invalid number literal: \033[0m'_'\033[31m cannot be immediately after the dot", line, file_name);
-            }
-            else if (pos < source_len && !isdigit(peek(1))) {
-                throw_exception(SUB_LEXER, "Invalid number literal: dot cannot be the end", line, file_name);
-            }
-            has_dot = true;
+        if (has_dot) {
+            throw_exception(SUB_LEXER, "Invalid number literal: twice dot", line, file_name);
+        }
+        else if (pos + 1 < source_len && source[pos + 1] == '_') {
+            throw_exception(SUB_LEXER, "Invalid number literal: \033[0m'_'\033[31m cannot be immediately after the dot", line, file_name);
+        }
+        else if (pos + 1 == source_len || !isdigit(source[pos + 1])) {
+            throw_exception(SUB_LEXER, "Invalid number literal: dot cannot be the end", line, file_name);
         }
-        value += advance();
+        has_dot = true;
+        pos++;
     }
 
+    const uint32_t digits_len = pos - start;
+    TokenType type = has_dot ? TOK_DOUBLE_LIT : TOK_INT_LIT;
     const char suffix = pos < source_len ? peek() : '\0';
     switch (tolower(suffix)) {
         case 'f':
             advance();
-            return Token(TOK_FLOAT_LIT, value, tmp_l, tmp_c, file_name);
+            type = TOK_FLOAT_LIT;
+            break;
         case 's':
             if (has_dot) {
                 throw_exception(SUB_LEXER, "Invalid number literal: specified suffix \033[0m's'\033[31m does not match for floating point literal", line, file_name);
             }
             advance();
-            return Token(TOK_SHORT_LIT, value, tmp_l, tmp_c, file_name);
+            type = TOK_SHORT_LIT;
+            break;
         case 'l':
             if (has_dot) {
                 throw_exception(SUB_LEXER, "Invalid number literal: specified suffix \033[0m'l'\033[31m does not match for floating point literal", line, file_name);
             }
             advance();
-            return Token(TOK_LONG_LIT, value, tmp_l, tmp_c, file_name);
+            type = TOK_LONG_LIT;
+            break;
         default:
-            if (has_dot) {
-                return Token(TOK_DOUBLE_LIT, value, tmp_l, tmp_c, file_name);
-            }
-            else {
-                return Token(TOK_INT_LIT, value, tmp_l, tmp_c, file_name);
+            break;
+    }
+
+    Token token = make_token(type, start, tmp_l, tmp_c);
+    parse_number_value(token, digits_len);
+    return token;
+}
+
+void Lexer::parse_number_value(Token& token, uint32_t digits_len) {
+    std::string_view digits = source.substr(token.offset, digits_len);
+    // digit separators are removed only if literal contains them, otherwise digits are parsed in place
+    std::string without_separators;
+    if (digits.find('_') != std::string_view::npos) {
+        without_separators.reserve(digits.size());
+        for (char c : digits) {
+            if (c != '_') {
+                without_separators += c;
             }
+        }
+        digits = without_separators;
     }
+
+    const char *first = digits.data();
+    const char *last = first + digits.size();
+    NumberValue value;
+    value.int_value = 0;
+    std::from_chars_result result;
+    const char *type_name;
+    bool is_integer = true;
+    int64_t min = INT64_MIN;
+    int64_t max = INT64_MAX;
+    switch (token.type) {
+        case TOK_FLOAT_LIT: {
+            float float_value = 0;
+            result = std::from_chars(first, last, float_value);
+            value.float_value = float_value;
+            type_name = "float";
+            is_integer = false;
+            break;
+        }
+        case TOK_DOUBLE_LIT:
+            result = std::from_chars(first, last, value.float_value);
+            type_name = "double";
+            is_integer = false;
+            break;
+        case TOK_SHORT_LIT:
+            result = std::from_chars(first, last, value.int_value);
+            type_name = "short";
+            min = INT16_MIN;
+            max = INT16_MAX;
+            break;
+        case TOK_INT_LIT:
+            result = std::from_chars(first, last, value.int_value);
+            type_name = "int";
+            min = INT32_MIN;
+            max = INT32_MAX;
+            break;
+        default:
+            result = std::from_chars(first, last, value.int_value);
+            type_name = "long";
+            break;
+    }
+
+    if (result.ec == std::errc::result_out_of_range || (is_integer && (value.int_value < min || value.int_value > max))) {
+        std::stringstream ss;
+        ss << "Number literal \033[0m'" << source.substr(token.offset, token.length) << "'\033[31m is out of range of type \033[0m'" << type_name << "'";
+        throw_exception(SUB_LEXER, ss.str(), token.line, file_name);
+    }
+    else if (result.ec != std::errc() || result.ptr != last) {
+        std::stringstream ss;
+        ss << "Invalid number literal: \033[0m'" << source.substr(token.offset, token.length) << "'";
+        throw_exception(SUB_LEXER, ss.str(), token.line, file_name);
+    }
+    token.value_index = number_values.size();
+    number_values.push_back(value);
 }
 
 Token Lexer::tokenize_string_lit() {
-    std::string value;
+    uint32_t start = pos;
     uint32_t tmp_l = line;
-    uint32_t tmp_c = column;
+    uint32_t tmp_c = get_column();
 
     advance();
-    while (pos < source_len && peek() != '\"') {
-        char c = advance();
-        if (c == '\\') {
-            c = get_escape_sequence();
+    while (true) {
+        pos = scan::find_string_special(source.data() + pos, source.data() + source_len, '\"') - source.data();
+        if (pos == source_len) {
+            throw_exception(SUB_LEXER, "Invalid string literal: missed closing double quote", line, file_name);
+        }
+        const char c = advance();
+        if (c == '\"') {
+            break;
+        }
+        else if (c == '\\') {
+            get_escape_sequence();
         }
-        value += c;
-    }
-    if (pos == source_len) {
-        throw_exception(SUB_LEXER, "Invalid string literal: missed closing double quote", line, file_name);
     }
-    advance();
 
-    return Token(TOK_STRING_LIT, value, tmp_l, tmp_c, file_name);
+    return make_token(TOK_STRING_LIT, start, tmp_l, tmp_c);
 }
 
 Token Lexer::tokenize_character_lit() {
-    std::string value;
+    uint32_t start = pos;
     uint32_t tmp_l = line;
-    uint32_t tmp_c = column;
+    uint32_t tmp_c = get_column();
+    uint32_t length = 0;
 
     advance();
     while (pos < source_len && peek() != '\'') {
-        char c = advance();
-        if (c == '\\') {
-            c = get_escape_sequence();
+        if (advance() == '\\') {
+            get_escape_sequence();
         }
-        value += c;
+        length++;
     }
     if (pos == source_len) {
         throw_exception(SUB_LEXER, "Invalid character literal: missed closing single quote", line, file_name);
     }
-    else if (value.length() != 1) {
+    else if (length != 1) {
         throw_exception(SUB_LEXER, "Invalid character literal: length should be equal to 1", line, file_name);
     }
     advance();
 
-    return Token(TOK_CHARACTER_LIT, value, tmp_l, tmp_c, file_name);
+    return make_token(TOK_CHARACTER_LIT, start, tmp_l, tmp_c);
 }
 
 Token Lexer::tokenize_op() {
+    uint32_t start = pos;
     uint32_t tmp_l = line;
-    uint32_t tmp_c = column;
+    uint32_t tmp_c = get_column();
     const char c = advance();
 
     switch (c) {
         case '+':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_PLUS_EQ, "+=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_PLUS_EQ, start, tmp_l, tmp_c);
             }
             else if (peek() == '+') {
                 advance();
-                return Token(TOK_OP_INC, "++", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_INC, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_PLUS, "+", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_PLUS, start, tmp_l, tmp_c);
         case '-':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_MINUS_EQ, "-=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_MINUS_EQ, start, tmp_l, tmp_c);
             }
             else if (peek() == '-') {
                 advance();
-                return Token(TOK_OP_DEC, "--", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_DEC, start, tmp_l, tmp_c);
             }
             else if (peek() == '>') {
                 advance();
-                return Token(TOK_OP_NEXT, "->", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_NEXT, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_MINUS, "-", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_MINUS, start, tmp_l, tmp_c);
         case '*':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_MULT_EQ, "*=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_MULT_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_MULT, "*", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_MULT, start, tmp_l, tmp_c);
         case '/':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_DIV_EQ, "/=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_DIV_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_DIV, "/", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_DIV, start, tmp_l, tmp_c);
         case '%':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_MODULO_EQ, "%=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_MODULO_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_MODULO, "%", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_MODULO, start, tmp_l, tmp_c);
         case '=':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_EQ_EQ, "==", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_EQ_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_EQ, "=", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_EQ, start, tmp_l, tmp_c);
         case '!':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_NOT_EQ_EQ, "!=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_NOT_EQ_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_L_NOT, "!", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_L_NOT, start, tmp_l, tmp_c);
         case '>':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_GT_EQ, ">=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_GT_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_GT, ">", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_GT, start, tmp_l, tmp_c);
         case '<':
             if (peek() == '=') {
                 advance();
-                return Token(TOK_OP_LS_EQ, "<=", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_LS_EQ, start, tmp_l, tmp_c);
             }
-            return Token(TOK_OP_LS, "<", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_LS, start, tmp_l, tmp_c);
         case '&':
             if (peek() == '&') {
                 advance();
-                return Token(TOK_OP_L_AND, "&&", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_L_AND, start, tmp_l, tmp_c);
             }
             throw_exception(SUB_LEXER, "Operator '&' (aka bitwise and) is unsupported", line, file_name);
         case '|':
             if (peek() == '|') {
                 advance();
-                return Token(TOK_OP_L_OR, "||", tmp_l, tmp_c, file_name);
+                return make_token(TOK_OP_L_OR, start, tmp_l, tmp_c);
             }
             throw_exception(SUB_LEXER, "Operator '|' (aka bitwise or) is unsupported", line, file_name);
         case ',':
-            return Token(TOK_OP_COMMA, ",", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_COMMA, start, tmp_l, tmp_c);
         case '.':
-            return Token(TOK_OP_DOT, ".", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_DOT, start, tmp_l, tmp_c);
         case ':':
-            return Token(TOK_OP_COLON, ":", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_COLON, start, tmp_l, tmp_c);
         case ';':
-            return Token(TOK_OP_SEMICOLON, ";", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_SEMICOLON, start, tmp_l, tmp_c);
         case '(':
-            return Token(TOK_OP_LPAREN, "(", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_LPAREN, start, tmp_l, tmp_c);
         case ')':
-            return Token(TOK_OP_RPAREN, ")", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_RPAREN, start, tmp_l, tmp_c);
         case '{':
-            return Token(TOK_OP_LBRACE, "{", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_LBRACE, start, tmp_l, tmp_c);
         case '}':
-            return Token(TOK_OP_RBRACE, "}", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_RBRACE, start, tmp_l, tmp_c);
         case '[':
-            return Token(TOK_OP_LBRACKET, "[", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_LBRACKET, start, tmp_l, tmp_c);
         case ']':
-            return Token(TOK_OP_RBRACKET, "]", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_RBRACKET, start, tmp_l, tmp_c);
         case '?':
-            return Token(TOK_OP_QUESTION, "?", tmp_l, tmp_c, file_name);
+            return make_token(TOK_OP_QUESTION, start, tmp_l, tmp_c);
         default:
             std::stringstream ss;
             ss << "Unsupported operator: \033[0m'" << c << "'";
@@ -274,16 +539,31 @@ Token Lexer::tokenize_op() {
     }
 }
 
-void Lexer::skip_comments() {
-    advance();
-    advance();
-    while (pos < source_len && peek() != '\n') {
+void Lexer::recover() {
+    while (pos < source_len && peek() != ' ' && peek() != '\n' && peek() != ';') {
         advance();
     }
 }
 
-const char Lexer::get_escape_sequence() {
-    const char c = advance();
+void Lexer::skip_whitespaces() {
+    const char *begin = source.data();
+    const char *line_begin = begin + line_start;
+    pos = scan::skip_whitespaces(begin + pos, begin + source_len, line, line_begin) - begin;
+    line_start = line_begin - begin;
+}
+
+void Lexer::skip_comments() {
+    pos = scan::find_line_end(source.data() + pos + 2, source.data() + source_len) - source.data();
+}
+
+/**
+ * @brief Function for decoding character of escape-sequence (after backslash)
+ *
+ * @param c Character after backslash
+ *
+ * @return Decoded character or '\0' if escape-sequence is unsupported
+ */
+static char decode_escape_sequence(char c) {
     switch (c) {
         case 'n':
             return '\n';
@@ -308,12 +588,38 @@ const char Lexer::get_escape_sequence() {
         case '?':
             return '\?';
         default:
-            std::stringstream ss;
-            ss << "Unsupported escape sequence: \033[0m'\\" << c;
-            throw_exception(SUB_LEXER, ss.str(), line, file_name);
+            return '\0';
     }
 }
 
+const char Lexer::get_escape_sequence() {
+    const char c = advance();
+    const char decoded = decode_escape_sequence(c);
+    if (decoded == '\0') {
+        std::stringstream ss;
+        ss << "Unsupported escape sequence: \033[0m'\\" << c;
+        throw_exception(SUB_LEXER, ss.str(), line, file_name);
+    }
+    return decoded;
+}
+
+Token Lexer::make_token(TokenType type, uint32_t start, uint32_t tmp_l, uint32_t tmp_c) const {
+    return Token(type, file_id, start, pos - start, tmp_l, tmp_c);
+}
+
+std::string get_string_lit_value(std::string_view text) {
+    std::string value;
+    value.reserve(text.size());
+    for (size_t i = 1; i + 1 < text.size(); i++) {
+        value += text[i] == '\\' ? decode_escape_sequence(text[++i]) : text[i];
+    }
+    return value;
+}
+
+char get_character_lit_value(std::string_view text) {
+    return text[1] == '\\' ? decode_escape_sequence(text[2]) : text[1];
+}
+
 const char Lexer::peek(int32_t rpos) const {
     if (pos + rpos >= source_len || pos + rpos < 0) {
         std::stringstream ss;
@@ -326,10 +632,9 @@ const char Lexer::peek(int32_t rpos) const {
 const char Lexer::advance() {
     const char c = peek();
     pos++;
-    column++;
     if (c == '\n') {
         line++;
-        column = 1;
+        line_start = pos;
     }
     return c;
 }
\ No newline at end of file
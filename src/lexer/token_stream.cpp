@@ -0,0 +1,48 @@
+/**
+ * @file token_stream.cpp
+ *
+ * @brief token_stream.hpp implementation
+ */
+
+#include "../../include/lexer/token_stream.hpp"
+
+bool TokenStream::has(int32_t rpos) {
+    int64_t index = static_cast<int64_t>(pos) + rpos;
+    if (index < 0 || (lexer != nullptr && index + WINDOW_SIZE < count)) {
+        return false;
+    }
+    while (index >= count && !exhausted) {
+        Token token;
+        if (lexer->next_token(token)) {
+            const uint32_t slot = count & (WINDOW_SIZE - 1);
+            // value is copied into the slot of token and table of values in lexer is cleared, so it does not grow with size of the source
+            if (token.type >= TOK_SHORT_LIT && token.type <= TOK_DOUBLE_LIT) {
+                window_values[slot] = lexer->get_number_value(token);
+                token.value_index = slot;
+            }
+            lexer->clear_number_values();
+            window[slot] = token;
+            count++;
+        }
+        else {
+            exhausted = true;
+        }
+    }
+    return index < count;
+}
+
+const Token *TokenStream::get_last() const {
+    if (count == 0) {
+        return nullptr;
+    }
+    return lexer == nullptr ? &tokens.back() : &window[(count - 1) & (WINDOW_SIZE - 1)];
+}
+
+void TokenStream::reset() {
+    pos = 0;
+    if (lexer != nullptr) {
+        lexer->reset();
+        count = 0;
+        exhausted = false;
+    }
+}
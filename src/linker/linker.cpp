@@ -0,0 +1,311 @@
+/**
+ * @file linker.cpp
+ *
+ * @brief linker.hpp implementation
+ */
+
+#include "../../include/linker/linker.hpp"
+#include <llvm/Support/raw_ostream.h>
+#include <llvm/Support/FileSystem.h>
+#include <llvm/ADT/SmallString.h>
+#include <filesystem>
+#include <cstdlib>
+#include <cstdio>
+#include <array>
+#if defined(TOPAZC_HAS_LLD)
+#include <lld/Common/Driver.h>
+#endif
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(TOPAZC_HAS_LLD)
+LLD_HAS_DRIVER(elf)
+#endif
+
+bool Linker::link(std::string& error) {
+    std::vector<std::string> inputs = object_paths;
+    std::vector<std::string> temp_files;
+    std::vector<int> fds;
+    for (auto& buffer : object_buffers) {
+        std::string path = materialize_buffer(*buffer, temp_files, fds, error);
+        if (path.empty()) {
+            return false;
+        }
+        inputs.push_back(path);
+    }
+
+    bool result = kind == LINKER_LLD ? link_lld(inputs, error) : link_external(inputs, error);
+
+    #if defined(__linux__)
+    for (int fd : fds) {
+        close(fd);
+    }
+    #endif
+    for (const std::string& path : temp_files) {
+        llvm::sys::fs::remove(path);
+    }
+    return result;
+}
+
+/**
+ * @brief Function for getting LTO optimization level number (size levels are mapped to 2 as in clang)
+ *
+ * @param level Optimization level
+ *
+ * @return LTO optimization level number
+ */
+static std::string get_lto_opt_level(OptLevel level) {
+    switch (level) {
+        case OPT_O0:
+            return "0";
+        case OPT_O1:
+            return "1";
+        case OPT_O3:
+            return "3";
+        default:
+            return "2";
+    }
+}
+
+bool Linker::link_external(const std::vector<std::string>& inputs, std::string& error) {
+    const char *env_linker = std::getenv("TOPAZC_LINKER");
+    std::string link_cmd = env_linker ? std::string(env_linker) : std::string("clang");
+    for (const std::string& input : inputs) {
+        link_cmd += " \"" + input + "\"";
+    }
+    link_cmd += " -o \"" + output_path + "\"";
+    #if defined(_WIN32)
+    link_cmd += " -fuse-ld=lld";
+    #elif !defined(__APPLE__)
+    link_cmd += " -no-pie";
+    #endif
+    if (profile_runtime) {
+        link_cmd += " -fprofile-generate";
+    }
+    if (thin_lto) {
+        link_cmd += " -flto=thin -O" + get_lto_opt_level(lto_opt_level);
+        if (lto_jobs != 0) {
+            link_cmd += " -flto-jobs=" + std::to_string(lto_jobs);
+        }
+        if (!lto_sample_profile.empty()) {
+            link_cmd += " -fprofile-sample-use=\"" + lto_sample_profile + "\"";
+        }
+        #if !defined(_WIN32) && !defined(__APPLE__)
+        link_cmd += " -fuse-ld=lld";
+        #endif
+    }
+
+    std::string output;
+    #if defined(_WIN32)
+    std::unique_ptr<FILE, int(*)(FILE*)> pipe(_popen(link_cmd.c_str(), "r"), _pclose);
+    #else
+    std::unique_ptr<FILE, int(*)(FILE*)> pipe(popen(link_cmd.c_str(), "r"), pclose);
+    #endif
+    if (!pipe) {
+        error = "Failed to spawn: " + link_cmd;
+        return false;
+    }
+    std::array<char, 512> buf{};
+    while (fgets(buf.data(), static_cast<int>(buf.size()), pipe.get()) != nullptr) {
+        output += buf.data();
+    }
+    #if defined(_WIN32)
+    int code = _pclose(pipe.release());
+    #else
+    int code = pclose(pipe.release());
+    #endif
+    if (code != 0) {
+        error = "Link command: " + link_cmd + '\n' + output + "\nLinking failed with code " + std::to_string(code);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Function for getting directories with startup files and C library
+ *
+ * Directories are prefixed with $TOPAZC_SYSROOT (if set)
+ *
+ * @param triple Target triple
+ *
+ * @return Library directories
+ */
+static std::vector<std::string> get_library_dirs(const llvm::Triple& triple) {
+    const char *env_sysroot = std::getenv("TOPAZC_SYSROOT");
+    std::string sysroot = env_sysroot ? env_sysroot : "";
+    std::string multiarch = triple.getArchName().str() + "-linux-gnu";
+    return {
+        sysroot + "/usr/lib/" + multiarch,
+        sysroot + "/lib/" + multiarch,
+        sysroot + "/usr/lib64",
+        sysroot + "/lib64",
+        sysroot + "/usr/lib",
+        sysroot + "/lib"
+    };
+}
+
+/**
+ * @brief Function for searching file in directories
+ *
+ * @param dirs Directories for searching
+ * @param name Name of file
+ *
+ * @return Path to the found file or empty string if file is not found
+ */
+static std::string find_file(const std::vector<std::string>& dirs, const std::string& name) {
+    for (const std::string& dir : dirs) {
+        std::string path = dir + '/' + name;
+        if (llvm::sys::fs::exists(path)) {
+            return path;
+        }
+    }
+    return "";
+}
+
+/**
+ * @brief Function for getting directory of the newest GCC installation (contains 'crtbegin.o' and 'crtend.o')
+ *
+ * @param triple Target triple
+ *
+ * @return Path to GCC installation or empty string if GCC is not installed
+ */
+static std::string find_gcc_dir(const llvm::Triple& triple) {
+    const char *env_sysroot = std::getenv("TOPAZC_SYSROOT");
+    std::filesystem::path root = std::string(env_sysroot ? env_sysroot : "") + "/usr/lib/gcc/" + triple.getArchName().str() + "-linux-gnu";
+    std::error_code ec;
+    std::string best;
+    int best_version = -1;
+    for (const auto& entry : std::filesystem::directory_iterator(root, ec)) {
+        std::string name = entry.path().filename().string();
+        int version = std::atoi(name.c_str());
+        if (version > best_version && std::filesystem::exists(entry.path() / "crtbegin.o")) {
+            best_version = version;
+            best = entry.path().string();
+        }
+    }
+    return best;
+}
+
+bool Linker::link_lld(const std::vector<std::string>& inputs, std::string& error) {
+    #if !defined(TOPAZC_HAS_LLD)
+    error = "topazc was built without lld. Please rebuild topazc with lld or use external linker";
+    return false;
+    #else
+    if (!triple.isOSBinFormatELF()) {
+        error = "In-process linking with lld is supported only for ELF targets, but target is '" + triple.str() + "'";
+        return false;
+    }
+
+    std::string emulation;
+    std::string dynamic_linker;
+    switch (triple.getArch()) {
+        case llvm::Triple::x86_64:
+            emulation = "elf_x86_64";
+            dynamic_linker = "/lib64/ld-linux-x86-64.so.2";
+            break;
+        case llvm::Triple::aarch64:
+            emulation = "aarch64linux";
+            dynamic_linker = "/lib/ld-linux-aarch64.so.1";
+            break;
+        default:
+            error = "In-process linking with lld does not support architecture '" + triple.getArchName().str() + "'";
+            return false;
+    }
+
+    std::vector<std::string> lib_dirs = get_library_dirs(triple);
+    std::string crt1 = find_file(lib_dirs, "crt1.o");
+    std::string crti = find_file(lib_dirs, "crti.o");
+    std::string crtn = find_file(lib_dirs, "crtn.o");
+    if (crt1.empty() || crti.empty() || crtn.empty()) {
+        error = "Could not find C runtime startup files (crt1.o, crti.o, crtn.o). Please set $TOPAZC_SYSROOT";
+        return false;
+    }
+    std::string gcc_dir = find_gcc_dir(triple);
+
+    std::vector<std::string> args = {
+        "ld.lld", "-o", output_path, "-m", emulation, "--hash-style=gnu", "--eh-frame-hdr", "-dynamic-linker", dynamic_linker, crt1, crti
+    };
+    if (!gcc_dir.empty()) {
+        args.push_back(gcc_dir + "/crtbegin.o");
+        args.push_back("-L" + gcc_dir);
+    }
+    for (const std::string& dir : lib_dirs) {
+        if (llvm::sys::fs::is_directory(dir)) {
+            args.push_back("-L" + dir);
+        }
+    }
+    if (thin_lto) {
+        args.push_back("--lto-O" + get_lto_opt_level(lto_opt_level));
+        args.push_back("--thinlto-jobs=" + (lto_jobs != 0 ? std::to_string(lto_jobs) : std::string("all")));
+        if (!lto_sample_profile.empty()) {
+            args.push_back("--lto-sample-profile=" + lto_sample_profile);
+        }
+    }
+    args.insert(args.end(), inputs.begin(), inputs.end());
+    if (profile_runtime) {
+        const char *profile_rt = std::getenv("TOPAZC_PROFILE_RT");
+        if (profile_rt == nullptr || *profile_rt == '\0') {
+            error = "Profile runtime is not found. Please set $TOPAZC_PROFILE_RT to the path of libclang_rt.profile";
+            return false;
+        }
+        args.insert(args.end(), { "-u", "__llvm_profile_runtime", profile_rt });
+    }
+    args.insert(args.end(), { "--as-needed", "-lm", "--no-as-needed", "-lc" });
+    if (!gcc_dir.empty()) {
+        args.push_back(gcc_dir + "/crtend.o");
+    }
+    args.push_back(crtn);
+
+    std::vector<const char*> argv;
+    for (const std::string& arg : args) {
+        argv.push_back(arg.c_str());
+    }
+
+    std::string output;
+    llvm::raw_string_ostream output_stream(output);
+    lld::Result result = lld::lldMain(argv, output_stream, output_stream, {{ lld::Gnu, &lld::elf::link }});
+    output_stream.flush();
+    if (result.retCode != 0) {
+        error = output + "\nLinking failed with code " + std::to_string(result.retCode);
+        return false;
+    }
+    return true;
+    #endif
+}
+
+std::string Linker::materialize_buffer(llvm::MemoryBuffer& buffer, std::vector<std::string>& temp_files, std::vector<int>& fds, std::string& error) {
+    llvm::StringRef data = buffer.getBuffer();
+    #if defined(__linux__)
+    if (kind == LINKER_LLD) {
+        int fd = memfd_create("topazc.o", MFD_CLOEXEC);
+        if (fd >= 0) {
+            size_t written = 0;
+            while (written < data.size()) {
+                ssize_t n = write(fd, data.data() + written, data.size() - written);
+                if (n <= 0) {
+                    break;
+                }
+                written += n;
+            }
+            fds.push_back(fd);
+            if (written == data.size()) {
+                return "/proc/self/fd/" + std::to_string(fd);
+            }
+        }
+    }
+    #endif
+
+    llvm::SmallString<128> path;
+    int fd = -1;
+    if (std::error_code ec = llvm::sys::fs::createTemporaryFile("topazc", "o", fd, path)) {
+        error = "Could not create temporary object file: " + ec.message();
+        return "";
+    }
+    llvm::raw_fd_ostream os(fd, true);
+    os << data;
+    os.close();
+    temp_files.push_back(path.str().str());
+    return path.str().str();
+}
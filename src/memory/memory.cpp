@@ -0,0 +1,89 @@
+/**
+ * @file memory.cpp
+ *
+ * @brief memory.hpp implementation
+ */
+
+#include "../../include/memory/memory.hpp"
+#include <llvm/Support/Format.h>
+#include <algorithm>
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+MemorySample sample_memory() {
+    MemorySample sample;
+    #if !defined(_WIN32)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        #if defined(__APPLE__)
+        sample.peak_rss = usage.ru_maxrss;
+        #else
+        sample.peak_rss = static_cast<size_t>(usage.ru_maxrss) * 1024;
+        #endif
+    }
+    if (FILE *statm = std::fopen("/proc/self/statm", "r")) {
+        unsigned long size;
+        unsigned long resident;
+        if (std::fscanf(statm, "%lu %lu", &size, &resident) == 2) {
+            sample.rss = static_cast<size_t>(resident) * sysconf(_SC_PAGESIZE);
+        }
+        std::fclose(statm);
+    }
+    #endif
+    #if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    struct mallinfo2 info = mallinfo2();
+    sample.heap = info.uordblks + info.hblkhd;
+    sample.heap_reserved = info.arena + info.hblkhd;
+    #endif
+    // RSS is not available without procfs, so peak is the best known value. Peak RSS of kernel is updated lazily
+    if (sample.rss == 0) {
+        sample.rss = sample.peak_rss;
+    }
+    sample.peak_rss = std::max(sample.peak_rss, sample.rss);
+    return sample;
+}
+
+size_t get_heap_growth(const MemorySample& before, const MemorySample& after) {
+    return after.heap > before.heap ? after.heap - before.heap : 0;
+}
+
+size_t get_tokens_memory(const std::vector<Token>& tokens) {
+    return tokens.capacity() * sizeof(Token);
+}
+
+const MemorySample& MemoryReport::record_phase(const std::string& name) {
+    phases.push_back({ name, sample_memory() });
+    max_sampled_heap = std::max(max_sampled_heap, phases.back().sample.heap);
+    return phases.back().sample;
+}
+
+void MemoryReport::record_structure(const std::string& name, size_t bytes) {
+    structures.push_back({ name, bytes });
+}
+
+void MemoryReport::print(llvm::raw_ostream& os) const {
+    auto mib = [](size_t bytes) {
+        return static_cast<double>(bytes) / (1024 * 1024);
+    };
+
+    os << "\033[1m\033[32mMemory report:\033[0m " << file_name << '\n';
+    os << "  Phase                  RSS, MiB      Peak, MiB      Heap, MiB  Reserved, MiB\n";
+    for (const Phase& phase : phases) {
+        os << llvm::format("  %-16s %14.2f %14.2f %14.2f %14.2f\n", phase.name.c_str(), mib(phase.sample.rss), mib(phase.sample.peak_rss),
+                           mib(phase.sample.heap), mib(phase.sample.heap_reserved));
+    }
+    // peak RSS is the kernel high-water mark, but heap is known only at phase boundaries, so transient peaks inside phases are missed
+    if (!phases.empty()) {
+        os << llvm::format("  Max sampled                     %14.2f %14.2f\n", mib(phases.back().sample.peak_rss), mib(max_sampled_heap));
+    }
+    os << "  Structure                             Size, MiB\n";
+    for (const Structure& structure : structures) {
+        os << llvm::format("  %-32s %14.2f\n", structure.name.c_str(), mib(structure.bytes));
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * @file optimizer.cpp
+ *
+ * @brief optimizer.hpp implementation
+ */
+
+#include "../../include/optimizer/optimizer.hpp"
+#include <llvm/Transforms/IPO/ThinLTOBitcodeWriter.h>
+#include <llvm/Passes/StandardInstrumentations.h>
+#include <llvm/Passes/OptimizationLevel.h>
+#include <llvm/Passes/PassBuilder.h>
+#include <llvm/Support/PGOOptions.h>
+#include <llvm/Support/VirtualFileSystem.h>
+#include <llvm/IR/PassManager.h>
+#include <optional>
+
+/**
+ * @brief Function for converting optimization level to PassBuilder optimization level
+ *
+ * @param level Optimization level
+ *
+ * @return Converted optimization level
+ */
+static llvm::OptimizationLevel opt_level_to_llvm(OptLevel level) {
+    switch (level) {
+        case OPT_O0:
+            return llvm::OptimizationLevel::O0;
+        case OPT_O1:
+            return llvm::OptimizationLevel::O1;
+        case OPT_O2:
+            return llvm::OptimizationLevel::O2;
+        case OPT_O3:
+            return llvm::OptimizationLevel::O3;
+        case OPT_OS:
+            return llvm::OptimizationLevel::Os;
+        case OPT_OZ:
+            return llvm::OptimizationLevel::Oz;
+    }
+    return llvm::OptimizationLevel::O0;
+}
+
+bool parse_opt_level(const std::string& option, OptLevel& level) {
+    if (option == "-O0") {
+        level = OPT_O0;
+    }
+    else if (option == "-O1") {
+        level = OPT_O1;
+    }
+    else if (option == "-O2" || option == "-O") {
+        level = OPT_O2;
+    }
+    else if (option == "-O3") {
+        level = OPT_O3;
+    }
+    else if (option == "-Os") {
+        level = OPT_OS;
+    }
+    else if (option == "-Oz") {
+        level = OPT_OZ;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+void Optimizer::optimize(llvm::Module& module, llvm::raw_ostream *thin_lto_bitcode) {
+    llvm::LoopAnalysisManager lam;
+    llvm::FunctionAnalysisManager fam;
+    llvm::CGSCCAnalysisManager cgam;
+    llvm::ModuleAnalysisManager mam;
+
+    llvm::PassInstrumentationCallbacks pic;
+    llvm::StandardInstrumentations si(module.getContext(), false);
+    si.registerCallbacks(pic, &mam);
+
+    llvm::PipelineTuningOptions pto;
+    pto.LoopUnrolling = level == OPT_O2 || level == OPT_O3;
+    pto.LoopVectorization = level == OPT_O2 || level == OPT_O3 || level == OPT_OS;
+    pto.SLPVectorization = level == OPT_O2 || level == OPT_O3 || level == OPT_OS;
+
+    std::optional<llvm::PGOOptions> pgo_options;
+    llvm::PGOOptions::PGOAction pgo_action = llvm::PGOOptions::NoAction;
+    switch (profile.kind) {
+        case PROFILE_GENERATE:
+            pgo_action = llvm::PGOOptions::IRInstr;
+            break;
+        case PROFILE_USE:
+            pgo_action = llvm::PGOOptions::IRUse;
+            break;
+        case PROFILE_SAMPLE_USE:
+            pgo_action = llvm::PGOOptions::SampleUse;
+            break;
+        default:
+            break;
+    }
+    if (pgo_action != llvm::PGOOptions::NoAction || profile.debug_info) {
+        pgo_options = llvm::PGOOptions(profile.path, "", "", "", llvm::vfs::getRealFileSystem(), pgo_action, llvm::PGOOptions::NoCSAction,
+                                       llvm::PGOOptions::ColdFuncOpt::Default, profile.debug_info);
+    }
+
+    llvm::PassBuilder pb(target_machine, pto, pgo_options, &pic);
+    pb.registerModuleAnalyses(mam);
+    pb.registerCGSCCAnalyses(cgam);
+    pb.registerFunctionAnalyses(fam);
+    pb.registerLoopAnalyses(lam);
+    pb.crossRegisterProxies(lam, fam, cgam, mam);
+
+    llvm::ModulePassManager mpm;
+    if (level == OPT_O0) {
+        mpm = pb.buildO0DefaultPipeline(llvm::OptimizationLevel::O0, thin_lto_bitcode ? llvm::ThinOrFullLTOPhase::ThinLTOPreLink : llvm::ThinOrFullLTOPhase::None);
+    }
+    else if (thin_lto_bitcode) {
+        mpm = pb.buildThinLTOPreLinkDefaultPipeline(opt_level_to_llvm(level));
+    }
+    else {
+        mpm = pb.buildPerModuleDefaultPipeline(opt_level_to_llvm(level));
+    }
+    if (thin_lto_bitcode) {
+        mpm.addPass(llvm::ThinLTOBitcodeWriterPass(*thin_lto_bitcode, nullptr));
+    }
+    mpm.run(module, mam);
+}
+
+llvm::CodeGenOptLevel Optimizer::get_codegen_opt_level(OptLevel level) {
+    switch (level) {
+        case OPT_O0:
+            return llvm::CodeGenOptLevel::None;
+        case OPT_O1:
+            return llvm::CodeGenOptLevel::Less;
+        case OPT_O3:
+            return llvm::CodeGenOptLevel::Aggressive;
+        default:
+            return llvm::CodeGenOptLevel::Default;
+    }
+}
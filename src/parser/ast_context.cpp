@@ -0,0 +1,56 @@
+/**
+ * @file ast_context.cpp
+ *
+ * @brief ast_context.hpp implementation
+ */
+
+#include "../../include/parser/ast_context.hpp"
+#include <cstring>
+
+std::string_view ASTContext::intern(std::string_view str) {
+    auto str_it = strings.find(str);
+    if (str_it != strings.end()) {
+        return *str_it;
+    }
+    char *data = static_cast<char *>(allocate(str.size(), 1));
+    std::memcpy(data, str.data(), str.size());
+    return *strings.emplace(data, str.size()).first;
+}
+
+const AST::Value *ASTContext::add_constant(AST::Value value) {
+    auto constant_it = constants.find(value.value);
+    if (constant_it != constants.end()) {
+        return constant_it->second;
+    }
+    const AST::Value *constant = create<AST::Value>(value);
+    constants.emplace(value.value, constant);
+    return constant;
+}
+
+bool ASTContext::ConstantEqual::operator()(const ConstantKey& left, const ConstantKey& right) const {
+    if (left.index() != right.index()) {
+        return false;
+    }
+    if (auto left_float = std::get_if<float>(&left)) {
+        return std::memcmp(left_float, std::get_if<float>(&right), sizeof(float)) == 0;
+    }
+    if (auto left_double = std::get_if<double>(&left)) {
+        return std::memcmp(left_double, std::get_if<double>(&right), sizeof(double)) == 0;
+    }
+    return left == right;
+}
+
+void *ASTContext::allocate_slow(size_t size) {
+    allocated_bytes += size;
+    // big allocation gets its own slab, so bump allocation continues in the current slab
+    if (size > SLAB_SIZE / 4) {
+        slabs.emplace_back(new char[size]);
+        slabs_bytes += size;
+        return slabs.back().get();
+    }
+    slabs.emplace_back(new char[SLAB_SIZE]);
+    slabs_bytes += SLAB_SIZE;
+    cur = slabs.back().get() + size;
+    end = slabs.back().get() + SLAB_SIZE;
+    return slabs.back().get();
+}
@@ -6,6 +6,7 @@
 
 #include "../../include/exception/exception.hpp"
 #include "../../include/parser/parser.hpp"
+#include "../../include/lexer/lexer.hpp"
 #include <iostream>
 #include <utility>
 #include <sstream>
@@ -15,15 +16,81 @@
 std::vector<AST::StmtPtr> Parser::parse() {
     std::vector<AST::StmtPtr> stmts;
 
-    while (pos < tokens_count) {
-        stmts.push_back(parse_stmt());
+    while (!tokens.at_end()) {
+        uint32_t start = tokens.get_pos();
+        try {
+            stmts.push_back(parse_stmt());
+        }
+        catch (const CompilationError& error) {
+            if (error.is_fatal()) {
+                throw;
+            }
+            synchronize(start);
+        }
     }
 
     return stmts;
 }
 
+void Parser::parse_block(std::vector<AST::StmtPtr>& block) {
+    while (!match(TOK_OP_RBRACE)) {
+        uint32_t start = tokens.get_pos();
+        try {
+            block.push_back(parse_stmt());
+        }
+        catch (const CompilationError& error) {
+            if (error.is_fatal() || tokens.at_end()) {
+                throw;
+            }
+            synchronize(start);
+        }
+    }
+}
+
+void Parser::synchronize(uint32_t start) {
+    // statement which failed on its first token is skipped, so parser always moves forward
+    if (tokens.get_pos() == start) {
+        tokens.advance();
+    }
+    uint32_t depth = 0;
+    while (!tokens.at_end()) {
+        switch (tokens.get(0).type) {
+            case TOK_OP_SEMICOLON:
+                if (depth == 0) {
+                    tokens.advance();
+                    return;
+                }
+                break;
+            case TOK_OP_LBRACE:
+                depth++;
+                break;
+            case TOK_OP_RBRACE:
+                if (depth == 0) {
+                    return;
+                }
+                depth--;
+                if (depth == 0) {
+                    tokens.advance();
+                    return;
+                }
+                break;
+            case TOK_LET:
+            case TOK_FUN:
+            case TOK_IF:
+            case TOK_RETURN:
+                if (depth == 0) {
+                    return;
+                }
+                break;
+            default:
+                break;
+        }
+        tokens.advance();
+    }
+}
+
 void Parser::reset() {
-    pos = 0;
+    tokens.reset();
 }
 
 AST::StmtPtr Parser::parse_stmt() {
@@ -47,8 +114,8 @@ AST::StmtPtr Parser::parse_stmt() {
     }
     else {
         std::stringstream ss;
-        ss << "Expected statement but got \033[0m'" << peek().value << "'\033[31m. Please check statement to mistakes";
-        throw_exception(SUB_PARSER, ss.str(), peek().line, peek().file_name);
+        ss << "Expected statement but got \033[0m'" << get_text(peek()) << "'\033[31m. Please check statement to mistakes";
+        throw_exception(SUB_PARSER, ss.str(), peek().line, get_file_name(peek()));
     }
 }
 
@@ -61,13 +128,13 @@ AST::StmtPtr Parser::parse_var_decl_stmt() {
     consume(TOK_OP_COLON, ss.str(), peek().line);
 
     ss.str("");
-    ss << "Expected variable name.\nToken \033[0m'" << peek().value << "'\033[31m is keyword or operator. Please replase it with unique identifier";
-    std::string name = consume(TOK_ID, ss.str(), peek().line).value;
+    ss << "Expected variable name.\nToken \033[0m'" << get_text(peek()) << "'\033[31m is keyword or operator. Please replase it with unique identifier";
+    std::string_view name = get_name(consume(TOK_ID, ss.str(), peek().line));
     AST::ExprPtr expr = nullptr;
-    if (pos == tokens_count) {
+    if (tokens.at_end()) {
         ss.str("");
         ss << "Expected \033[0m';'\033[31m in the end of variable definition. Please add \033[0m';'\033[31m into the end of variable definition";
-        throw_exception(SUB_PARSER, ss.str(), peek(-1).line, peek(-1).file_name);
+        throw_exception(SUB_PARSER, ss.str(), peek(-1).line, get_file_name(peek(-1)));
     }
     if (match(TOK_OP_EQ)) {
         expr = parse_expr();
@@ -75,15 +142,15 @@ AST::StmtPtr Parser::parse_var_decl_stmt() {
     
     ss.str("");
     ss << "Expected \033[0m';'\033[31m in the end of variable definition. ";
-    if (pos == tokens_count) {
+    if (tokens.at_end()) {
         ss << "Please add \033[0m';'\033[31m into the end of variable definition";
     }
     else {
-        ss << "Please replace \033[0m'" << peek().value << "'\033[31m with \033[0m';'";
+        ss << "Please replace \033[0m'" << get_text(peek()) << "'\033[31m with \033[0m';'";
     }
     consume(TOK_OP_SEMICOLON, ss.str(), peek().line);
 
-    return std::make_unique<AST::VarDeclStmt>(type, std::move(expr), name, first_token.line);
+    return context.create<AST::VarDeclStmt>(type, expr, name, first_token.line);
 }
 
 AST::StmtPtr Parser::parse_var_asgn_stmt() {
@@ -93,28 +160,28 @@ AST::StmtPtr Parser::parse_var_asgn_stmt() {
         expr = parse_expr();
     }
     else if (is_compound_asgn_operator(peek())) {
-        expr = create_compound_asgn_operator(var_token.value);
+        expr = create_compound_asgn_operator(get_name(var_token));
     }
     else {
-        expr = create_inc_dec_operator(var_token.value);
+        expr = create_inc_dec_operator(get_name(var_token));
     }
     std::stringstream ss;
     ss << "Expected \033[0m';'\033[31m in the end of variable definition. ";
-    if (pos == tokens_count) {
+    if (tokens.at_end()) {
         ss << "Please add \033[0m';'\033[31m into the end of variable definition";
     }
     else {
-        ss << "Please replace \033[0m'" << peek().value << "'\033[31m with \033[0m';'";
+        ss << "Please replace \033[0m'" << get_text(peek()) << "'\033[31m with \033[0m';'";
     }
     consume(TOK_OP_SEMICOLON, ss.str(), peek().line);
-    return std::make_unique<AST::VarAsgnStmt>(var_token.value, std::move(expr), var_token.line);
+    return context.create<AST::VarAsgnStmt>(get_name(var_token), expr, var_token.line);
 }
 
 AST::StmtPtr Parser::parse_func_decl_stmt() {
     Token first_token = peek(-1);
     std::stringstream ss;
-    ss << "Expected function name.\nToken \033[0m'" << peek().value << "'\033[31m is keyword or operator. Please replase it with unique identifier";
-    std::string name = consume(TOK_ID, ss.str(), peek().line).value;
+    ss << "Expected function name.\nToken \033[0m'" << get_text(peek()) << "'\033[31m is keyword or operator. Please replase it with unique identifier";
+    std::string_view name = get_name(consume(TOK_ID, ss.str(), peek().line));
     std::vector<AST::Argument> args;
     if (match(TOK_OP_LPAREN)) {
         while (!match(TOK_OP_RPAREN)) {
@@ -122,8 +189,8 @@ AST::StmtPtr Parser::parse_func_decl_stmt() {
             if (peek().type != TOK_OP_RPAREN) {
                 ss.str("");
                 ss << "Expected \033[0m','\033[31m between function arguments.\nPlease replace \033[0m'";
-                ss << args[args.size() - 1].name << ": " << args[args.size() - 1].type.to_str() << " " << peek().value << "'\033[31m with: \033[0m'"
-                   << args[args.size() - 1].name << ": " << args[args.size() - 1].type.to_str() << ", " << peek().value << "'";
+                ss << args[args.size() - 1].name << ": " << args[args.size() - 1].type.to_str() << " " << get_text(peek()) << "'\033[31m with: \033[0m'"
+                   << args[args.size() - 1].name << ": " << args[args.size() - 1].type.to_str() << ", " << get_text(peek()) << "'";
                 consume(TOK_OP_COMMA, ss.str(), peek().line);
             }
         }
@@ -136,11 +203,9 @@ AST::StmtPtr Parser::parse_func_decl_stmt() {
     
     std::vector<AST::StmtPtr> block;
     consume(TOK_OP_LBRACE, "Expected \033[0m'{'\033[31m after funtion arguments. Prototypes of functions is unsupported in current Topaz compiler version", peek().line);
-    while (!match(TOK_OP_RBRACE)) {
-        block.push_back(parse_stmt());
-    }
+    parse_block(block);
 
-    return std::make_unique<AST::FuncDeclStmt>(name, std::move(args), ret_type, std::move(block), first_token.line);
+    return context.create<AST::FuncDeclStmt>(name, context.copy_array(args), ret_type, context.copy_array(block), first_token.line);
 }
 
 AST::StmtPtr Parser::parse_func_call_stmt() {
@@ -151,27 +216,27 @@ AST::StmtPtr Parser::parse_func_call_stmt() {
         if (peek().type != TOK_OP_RPAREN) {
             std::stringstream ss;
             ss << "Expected \033[0m','\033[31m between function arguments.\nPlease replace \033[0m'";
-            ss << peek(-1).value << " " << peek().value << "'\033[31m with: \033[0m'"
-               << peek(-1).value << ", " << peek().value << "'";
+            ss << get_text(peek(-1)) << " " << get_text(peek()) << "'\033[31m with: \033[0m'"
+               << get_text(peek(-1)) << ", " << get_text(peek()) << "'";
             consume(TOK_OP_COMMA, ss.str(), peek().line);
         }
     }
     std::stringstream ss;
     ss << "Expected \033[0m';'\033[31m in the end of function calling. ";
-    if (pos == tokens_count) {
+    if (tokens.at_end()) {
         ss << "Please add \033[0m';'\033[31m into the end of function calling";
     }
     else {
-        ss << "Please replace \033[0m'" << peek().value << "'\033[31m with \033[0m';'";
+        ss << "Please replace \033[0m'" << get_text(peek()) << "'\033[31m with \033[0m';'";
     }
     consume(TOK_OP_SEMICOLON, ss.str(), peek().line);
-    return std::make_unique<AST::FuncCallStmt>(name_token.value, std::move(args), name_token.line);
+    return context.create<AST::FuncCallStmt>(get_name(name_token), context.copy_array(args), name_token.line);
 }
 
 AST::Argument Parser::parse_argument() {
     std::stringstream ss;
-    ss << "Expected function argument name.\nToken \033[0m'" << peek().value << "'\033[31m is keyword or operator. Please replase it with unique identifier";
-    std::string name = consume(TOK_ID, ss.str(), peek().line).value;
+    ss << "Expected function argument name.\nToken \033[0m'" << get_text(peek()) << "'\033[31m is keyword or operator. Please replase it with unique identifier";
+    std::string_view name = get_name(consume(TOK_ID, ss.str(), peek().line));
 
     ss.str("");
     ss << "Expected \033[0m':'\033[31m between function argument name and type.\nPlease replace \033[0m'";
@@ -189,7 +254,7 @@ AST::StmtPtr Parser::parse_return_stmt() {
         ret_expr = parse_expr();
         consume(TOK_OP_SEMICOLON, "Expected ';' after returned expression", peek().line);
     }
-    return std::make_unique<AST::ReturnStmt>(std::move(ret_expr), first_token.line);
+    return context.create<AST::ReturnStmt>(ret_expr, first_token.line);
 }
 
 AST::StmtPtr Parser::parse_if_else_stmt() {
@@ -197,21 +262,17 @@ AST::StmtPtr Parser::parse_if_else_stmt() {
     AST::ExprPtr cond = parse_expr();
     std::vector<AST::StmtPtr> then_block;
     consume(TOK_OP_LBRACE, "Expected \033[0m'{'\033[31m after condition", peek().line);
-    while (!match(TOK_OP_RBRACE)) {
-        then_block.push_back(parse_stmt());
-    }
+    parse_block(then_block);
     std::vector<AST::StmtPtr> else_block;
     if (match(TOK_ELSE)) {
         if (match(TOK_OP_LBRACE)) {
-            while (!match(TOK_OP_RBRACE)) {
-                else_block.push_back(parse_stmt());
-            }
+            parse_block(else_block);
         }
         else {
             else_block.push_back(parse_stmt());
         }
     }
-    return std::make_unique<AST::IfElseStmt>(std::move(cond), std::move(then_block), std::move(else_block), first_token.line);
+    return context.create<AST::IfElseStmt>(cond, context.copy_array(then_block), context.copy_array(else_block), first_token.line);
 }
 
 AST::ExprPtr Parser::parse_expr() {
@@ -222,7 +283,7 @@ AST::ExprPtr Parser::parse_l_and_expr() {
     AST::ExprPtr expr = parse_l_or_expr();
     while (match(TOK_OP_L_AND)) {
         Token token = peek(-1);
-        expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_l_or_expr(), token.line);
+        expr = context.create<AST::BinaryExpr>(AST::BIN_OP_L_AND, expr, parse_l_or_expr(), token.line);
     }
     return expr;
 }
@@ -231,7 +292,7 @@ AST::ExprPtr Parser::parse_l_or_expr() {
     AST::ExprPtr expr = parse_equality_expr();
     while (match(TOK_OP_L_OR)) {
         Token token = peek(-1);
-        expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_equality_expr(), token.line);
+        expr = context.create<AST::BinaryExpr>(AST::BIN_OP_L_OR, expr, parse_equality_expr(), token.line);
     }
     return expr;
 }
@@ -241,10 +302,10 @@ AST::ExprPtr Parser::parse_equality_expr() {
     while (1) {
         Token token = peek();
         if (match(TOK_OP_EQ_EQ)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_comparation_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_EQ_EQ, expr, parse_comparation_expr(), token.line);
         }
         else if (match(TOK_OP_NOT_EQ_EQ)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_comparation_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_NOT_EQ_EQ, expr, parse_comparation_expr(), token.line);
         }
         else {
             break;
@@ -258,16 +319,16 @@ AST::ExprPtr Parser::parse_comparation_expr() {
     while (1) {
         Token token = peek();
         if (match(TOK_OP_GT)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_additive_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_GT, expr, parse_additive_expr(), token.line);
         }
         else if (match(TOK_OP_GT_EQ)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_additive_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_GT_EQ, expr, parse_additive_expr(), token.line);
         }
         else if (match(TOK_OP_LS)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_additive_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_LS, expr, parse_additive_expr(), token.line);
         }
         else if (match(TOK_OP_LS_EQ)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_additive_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_LS_EQ, expr, parse_additive_expr(), token.line);
         }
         else {
             break;
@@ -281,10 +342,10 @@ AST::ExprPtr Parser::parse_additive_expr() {
     while (1) {
         Token token = peek();
         if (match(TOK_OP_PLUS)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_multiplicative_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_PLUS, expr, parse_multiplicative_expr(), token.line);
         }
         else if (match(TOK_OP_MINUS)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_multiplicative_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_MINUS, expr, parse_multiplicative_expr(), token.line);
         }
         else {
             break;
@@ -298,13 +359,13 @@ AST::ExprPtr Parser::parse_multiplicative_expr() {
     while (1) {
         Token token = peek();
         if (match(TOK_OP_MULT)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_unary_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_MULT, expr, parse_unary_expr(), token.line);
         }
         else if (match(TOK_OP_DIV)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_unary_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_DIV, expr, parse_unary_expr(), token.line);
         }
         else if (match(TOK_OP_MODULO)) {
-            expr = std::make_unique<AST::BinaryExpr>(token, std::move(expr), parse_unary_expr(), token.line);
+            expr = context.create<AST::BinaryExpr>(AST::BIN_OP_MODULO, expr, parse_unary_expr(), token.line);
         }
         else {
             break;
@@ -317,10 +378,10 @@ AST::ExprPtr Parser::parse_unary_expr() {
     Token token = peek();
     while (1) {
         if (match(TOK_OP_MINUS)) {
-            return std::make_unique<AST::UnaryExpr>(token, parse_primary_expr(), token.line);
+            return context.create<AST::UnaryExpr>(AST::UN_OP_MINUS, parse_primary_expr(), token.line);
         }
         else if (match(TOK_OP_L_NOT)) {
-            return std::make_unique<AST::UnaryExpr>(token, parse_primary_expr(), token.line);
+            return context.create<AST::UnaryExpr>(AST::UN_OP_L_NOT, parse_primary_expr(), token.line);
         }
         else {
             break;
@@ -333,12 +394,13 @@ AST::ExprPtr Parser::parse_primary_expr() {
     Token token = peek();
     switch (token.type) {
         case TOK_OP_LPAREN: {
+            tokens.advance();
             AST::ExprPtr expr = parse_expr();
             consume(TOK_OP_RPAREN, "Expected ')'. You forgot to specify the closing ')'", token.line);
             return expr;
         }
         case TOK_ID:
-            pos++;
+            tokens.advance();
             if (match(TOK_OP_LPAREN)) {
                 std::vector<AST::ExprPtr> args;
                 while (!match(TOK_OP_RPAREN)) {
@@ -346,60 +408,61 @@ AST::ExprPtr Parser::parse_primary_expr() {
                     if (peek().type != TOK_OP_RPAREN) {
                         std::stringstream ss;
                         ss << "Expected \033[0m','\033[31m between function arguments.\nPlease replace \033[0m'";
-                        ss << peek(-1).value << " " << peek().value << "'\033[31m with: \033[0m'"
-                        << peek(-1).value << ", " << peek().value << "'";
+                        ss << get_text(peek(-1)) << " " << get_text(peek()) << "'\033[31m with: \033[0m'"
+                        << get_text(peek(-1)) << ", " << get_text(peek()) << "'";
                         consume(TOK_OP_COMMA, ss.str(), peek().line);
                     }
                 }
-                return std::make_unique<AST::FuncCallExpr>(token.value, std::move(args), token.line);
+                return context.create<AST::FuncCallExpr>(get_name(token), context.copy_array(args), token.line);
             }
             else if (peek().type == TOK_OP_INC || peek().type == TOK_OP_DEC) {
-                return create_inc_dec_operator(token.value);
+                return create_inc_dec_operator(get_name(token));
             }
-            return std::make_unique<AST::VarExpr>(token.value, token.line);
+            return context.create<AST::VarExpr>(get_name(token), token.line);
         case TOK_CHARACTER_LIT:
-            pos++;
-            return std::make_unique<AST::CharacterLiteral>(token.value[0], token.line);
+            tokens.advance();
+            return context.create<AST::CharacterLiteral>(context.add_constant(AST::Value(static_cast<char8_t>(get_character_lit_value(sources.get_text(token))))), token.line);
         case TOK_SHORT_LIT:
-            pos++;
-            return std::make_unique<AST::ShortLiteral>(std::stoll(token.value), token.line);
+            tokens.advance();
+            return context.create<AST::ShortLiteral>(context.add_constant(AST::Value(static_cast<int16_t>(tokens.get_number_value(token).int_value))), token.line);
         case TOK_INT_LIT:
-            pos++;
-            return std::make_unique<AST::IntLiteral>(std::stoll(token.value), token.line);
+            tokens.advance();
+            return context.create<AST::IntLiteral>(context.add_constant(AST::Value(static_cast<int32_t>(tokens.get_number_value(token).int_value))), token.line);
         case TOK_LONG_LIT:
-            pos++;
-            return std::make_unique<AST::LongLiteral>(std::stoll(token.value), token.line);
+            tokens.advance();
+            return context.create<AST::LongLiteral>(context.add_constant(AST::Value(tokens.get_number_value(token).int_value)), token.line);
         case TOK_FLOAT_LIT:
-            pos++;
-            return std::make_unique<AST::FloatLiteral>(std::stold(token.value), token.line);
+            tokens.advance();
+            return context.create<AST::FloatLiteral>(context.add_constant(AST::Value(static_cast<float>(tokens.get_number_value(token).float_value))), token.line);
         case TOK_DOUBLE_LIT:
-            pos++;
-            return std::make_unique<AST::DoubleLiteral>(std::stold(token.value), token.line);
+            tokens.advance();
+            return context.create<AST::DoubleLiteral>(context.add_constant(AST::Value(tokens.get_number_value(token).float_value)), token.line);
         case TOK_BOOLEAN_LIT:
-            pos++;
-            return std::make_unique<AST::BoolLiteral>(token.value == "true", token.line);
+            tokens.advance();
+            return context.create<AST::BoolLiteral>(context.add_constant(AST::Value(sources.get_text(token) == "true")), token.line);
         case TOK_STRING_LIT:
-            pos++;
-            return std::make_unique<AST::StringLiteral>(token.value, token.line);
+            tokens.advance();
+            return context.create<AST::StringLiteral>(context.add_constant(AST::Value(context.intern(get_string_lit_value(sources.get_text(token))))), token.line);
         default:
             std::stringstream ss;
-            ss << "Expected expression, but got \033[0m'" << peek().value << "'\033[31m. Please check expression to mistakes";
-            throw_exception(SUB_PARSER, ss.str(), token.line, token.file_name);
+            ss << "Expected expression, but got \033[0m'" << get_text(peek()) << "'\033[31m. Please check expression to mistakes";
+            throw_exception(SUB_PARSER, ss.str(), token.line, get_file_name(token));
     }
 }
 
-Token Parser::peek(int32_t rpos) const {
-    if (pos + rpos >= tokens_count || pos + rpos < 0) {
+Token Parser::peek(int32_t rpos) {
+    if (!tokens.has(rpos)) {
         std::stringstream ss;
-        ss << "Index out of range: " << pos + rpos << '/' << tokens_count;
-        throw_exception(SUB_PARSER, ss.str(), peek().line, peek().file_name);
+        ss << "Unexpected end of file (index out of range: " << static_cast<int64_t>(tokens.get_pos()) + rpos << ')';
+        const Token *last = tokens.get_last();
+        throw_exception(SUB_PARSER, ss.str(), last == nullptr ? 1 : last->line, last == nullptr ? "" : get_file_name(*last));
     }
-    return tokens[pos + rpos];
+    return tokens.get(rpos);
 }
 
 bool Parser::match(TokenType type) {
     if (peek().type == type) {
-        pos++;
+        tokens.advance();
         return true;
     }
     return false;
@@ -410,7 +473,7 @@ Token Parser::consume(TokenType type, std::string err_msg, uint32_t line) {
     if (match(type)) {
         return token;
     }
-    throw_exception(SUB_PARSER, err_msg, line, token.file_name);
+    throw_exception(SUB_PARSER, err_msg, line, get_file_name(token));
 }
 
 AST::Type Parser::consume_type() {
@@ -430,16 +493,16 @@ AST::Type Parser::consume_type() {
         case TOK_DOUBLE:
         case TOK_NOTH: {
             Token type = peek();
-            pos++;
+            tokens.advance();
             if (match(TOK_OP_QUESTION)) {
                 is_nullable = true;
             }
-            return AST::Type(ttype_to_tvalue(type.type), type.value, is_const, false, is_nullable);
+            return AST::Type(ttype_to_tvalue(type.type), get_name(type), is_const, false, is_nullable);
         }
         default: {
             std::stringstream ss;
-            ss << "Token \033[0m'" << peek().value << "'\033[31m is not type. Please replase it to exists type";
-            throw_exception(SUB_PARSER, ss.str(), peek().line, peek().file_name);
+            ss << "Token \033[0m'" << get_text(peek()) << "'\033[31m is not type. Please replase it to exists type";
+            throw_exception(SUB_PARSER, ss.str(), peek().line, get_file_name(peek()));
         }
     }
 }
@@ -464,8 +527,8 @@ AST::TypeValue Parser::ttype_to_tvalue(TokenType type) {
             return AST::TYPE_NOTH;
         default:
             std::stringstream ss;
-            ss << "Token \033[0m'" << peek().value << "'\033[31m is not type. Please replase it to exists types";
-            throw_exception(SUB_PARSER, ss.str(), peek().line, peek().file_name);
+            ss << "Token \033[0m'" << get_text(peek()) << "'\033[31m is not type. Please replase it to exists types";
+            throw_exception(SUB_PARSER, ss.str(), peek().line, get_file_name(peek()));
     }
 }
 
@@ -482,40 +545,40 @@ bool Parser::is_compound_asgn_operator(Token token) {
     }
 }
 
-AST::ExprPtr Parser::create_compound_asgn_operator(std::string var_name) {
+AST::ExprPtr Parser::create_compound_asgn_operator(std::string_view var_name) {
     Token token = peek();
-    pos++;
+    tokens.advance();
     switch (token.type) {
         case TOK_OP_PLUS_EQ:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_PLUS, "+", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_PLUS, context.create<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
         case TOK_OP_MINUS_EQ:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_MINUS, "-", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_MINUS, context.create<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
         case TOK_OP_MULT_EQ:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_MULT, "*", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_MULT, context.create<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
         case TOK_OP_DIV_EQ:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_DIV, "/", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_DIV, context.create<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
         case TOK_OP_MODULO_EQ:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_MODULO, "%", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_MODULO, context.create<AST::VarExpr>(var_name, token.line), parse_expr(), token.line);
         default: {
             std::stringstream ss;
-            ss << "Unsupported compound assignment operator: \033[0m'" << token.value << "'\033[31m. Please check your Topaz compiler version and fix the problematic section of the code";
-            throw_exception(SUB_PARSER, ss.str(), token.line, peek().file_name);
+            ss << "Unsupported compound assignment operator: \033[0m'" << get_text(token) << "'\033[31m. Please check your Topaz compiler version and fix the problematic section of the code";
+            throw_exception(SUB_PARSER, ss.str(), token.line, get_file_name(peek()));
         }
     }
 }
 
-AST::ExprPtr Parser::create_inc_dec_operator(std::string var_name) {
+AST::ExprPtr Parser::create_inc_dec_operator(std::string_view var_name) {
     Token token = peek();
-    pos++;
+    tokens.advance();
     switch (token.type) {
         case TOK_OP_INC:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_PLUS, "+", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), std::make_unique<AST::IntLiteral>(1, token.line), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_PLUS, context.create<AST::VarExpr>(var_name, token.line), context.create<AST::IntLiteral>(context.add_constant(AST::Value(1)), token.line), token.line);
         case TOK_OP_DEC:
-            return std::make_unique<AST::BinaryExpr>(Token(TOK_OP_MINUS, "-", token.line, token.column, token.file_name), std::make_unique<AST::VarExpr>(var_name, token.line), std::make_unique<AST::IntLiteral>(1, token.line), token.line);
+            return context.create<AST::BinaryExpr>(AST::BIN_OP_MINUS, context.create<AST::VarExpr>(var_name, token.line), context.create<AST::IntLiteral>(context.add_constant(AST::Value(1)), token.line), token.line);
         default: {
             std::stringstream ss;
-            ss << "Unsupported increment/decrement operator: \033[0m'" << token.value << "'\033[31m. Please check your Topaz compiler version and fix the problematic section of the code";
-            throw_exception(SUB_PARSER, ss.str(), token.line, peek().file_name);
+            ss << "Unsupported increment/decrement operator: \033[0m'" << get_text(token) << "'\033[31m. Please check your Topaz compiler version and fix the problematic section of the code";
+            throw_exception(SUB_PARSER, ss.str(), token.line, get_file_name(peek()));
         }
     }
 }
\ No newline at end of file
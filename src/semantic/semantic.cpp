@@ -6,6 +6,7 @@
 
 #include "../../include/exception/exception.hpp"
 #include "../../include/semantic/semantic.hpp"
+#include <llvm/Support/TimeProfiler.h>
 #include <algorithm>
 #include <cstddef>
 #include <sstream>
@@ -14,7 +15,26 @@
 
 void SemanticAnalyzer::analyze() {
     for (const AST::StmtPtr& stmt : stmts) {
-        analyze_stmt(*stmt);
+        analyze_stmt_with_recovery(*stmt);
+    }
+}
+
+void SemanticAnalyzer::analyze_stmt_with_recovery(AST::Stmt& stmt) {
+    size_t variables_depth = variables.size();
+    size_t functions_depth = functions_ret_types.size();
+    try {
+        analyze_stmt(stmt);
+    }
+    catch (const CompilationError& error) {
+        if (error.is_fatal()) {
+            throw;
+        }
+        while (variables.size() > variables_depth) {
+            variables.pop();
+        }
+        while (functions_ret_types.size() > functions_depth) {
+            functions_ret_types.pop();
+        }
     }
 }
 
@@ -79,6 +99,7 @@ void SemanticAnalyzer::analyze_var_asgn_stmt(AST::VarAsgnStmt& vas) {
 }
 
 void SemanticAnalyzer::analyze_func_decl_stmt(AST::FuncDeclStmt& fds) {
+    llvm::TimeTraceScope scope("SemanticFunction", fds.name);
     FunctionInfo *func = get_function_info(fds.name);
     if (func != nullptr) {
         std::stringstream ss;
@@ -86,13 +107,14 @@ void SemanticAnalyzer::analyze_func_decl_stmt(AST::FuncDeclStmt& fds) {
         throw_exception(SUB_SEMANTIC, ss.str(), fds.line, file_name);
     }
     AST::Type ret_type = fds.ret_type;
-    functions.emplace(fds.name, new FunctionInfo{.ret_type=ret_type, .args=std::move(fds.args), .block=std::move(fds.block)});
+    functions.emplace(fds.name, new FunctionInfo{.ret_type=ret_type, .args=fds.args, .block=fds.block});
     functions_ret_types.push(ret_type);
-    for (auto& arg : functions.at(fds.name)->args) {
-        analyze_var_decl_stmt(*std::make_unique<AST::VarDeclStmt>(arg.type, nullptr, arg.name, fds.line));
+    for (auto& arg : fds.args) {
+        AST::VarDeclStmt arg_decl(arg.type, nullptr, arg.name, fds.line);
+        analyze_var_decl_stmt(arg_decl);
     }
-    for (auto& stmt : functions.at(fds.name)->block) {
-        analyze_stmt(*stmt);
+    for (auto& stmt : fds.block) {
+        analyze_stmt_with_recovery(*stmt);
     }
     functions_ret_types.pop();
 }
@@ -104,17 +126,17 @@ void SemanticAnalyzer::analyze_func_call_stmt(AST::FuncCallStmt& fcs) {
         ss << "Function \033[0m'" << fcs.name << "'\033[31m does not exists";
         throw_exception(SUB_SEMANTIC, ss.str(), fcs.line, file_name);
     }
-    if (fcs.args.size() != functions.at(fcs.name)->args.size()) {
+    if (fcs.args.size() != func->args.size()) {
         std::stringstream ss;
-        ss << "Function \033[0m'" << fcs.name << "'\033[31m expected " << functions.at(fcs.name)->args.size() << " arguments, but got " << fcs.args.size();
+        ss << "Function \033[0m'" << fcs.name << "'\033[31m expected " << func->args.size() << " arguments, but got " << fcs.args.size();
         throw_exception(SUB_SEMANTIC, ss.str(), fcs.line, file_name);
     }
     size_t index = 0;
     for (auto& arg : fcs.args) {
         AST::Type arg_type = analyze_expr(*arg).type;
-        if (!has_common_type(arg_type, functions.at(fcs.name)->args[index].type)) {
+        if (!has_common_type(arg_type, func->args[index].type)) {
             std::stringstream ss;
-            ss << "Type mismatch: an expression of the type \033[0m'" << arg_type.to_str() << "'\033[31m, but the type is expected \033[0m'" << functions.at(fcs.name)->args[index].type.to_str() << "'\033[31m";
+            ss << "Type mismatch: an expression of the type \033[0m'" << arg_type.to_str() << "'\033[31m, but the type is expected \033[0m'" << func->args[index].type.to_str() << "'\033[31m";
             throw_exception(SUB_SEMANTIC, ss.str(), fcs.line, file_name);
         }
         index++;
@@ -176,7 +198,7 @@ SemanticAnalyzer::Value SemanticAnalyzer::analyze_expr(AST::Expr& expr) {
 }
 
 SemanticAnalyzer::Value SemanticAnalyzer::analyze_literal_expr(AST::Literal& lit) {
-    return Value(lit.type, lit.value);
+    return Value(lit.get_type(), *lit.value);
 }
 
 SemanticAnalyzer::Value SemanticAnalyzer::analyze_binary_expr(AST::BinaryExpr& be) {
@@ -190,68 +212,69 @@ SemanticAnalyzer::Value SemanticAnalyzer::analyze_binary_expr(AST::BinaryExpr& b
     if (left_type.type >= AST::TYPE_BOOL && left_type.type <= AST::TYPE_DOUBLE && right_type.type > AST::TYPE_DOUBLE ||
         right_type.type >= AST::TYPE_BOOL && right_type.type <= AST::TYPE_DOUBLE && left_type.type > AST::TYPE_DOUBLE) {
         std::stringstream ss;
-        ss << "Type mismatch: it is not possible to use the binary \033[0m'" << be.op.value <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
+        ss << "Type mismatch: it is not possible to use the binary \033[0m'" << AST::get_binary_op_spelling(be.op) <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
         throw_exception(SUB_SEMANTIC, ss.str(), be.line, file_name);
     }
     else {
         if (left_type.type == AST::TYPE_STRING_LIT && right_type.type == AST::TYPE_STRING_LIT) {
-            if (be.op.type != TOK_OP_PLUS) {
+            if (be.op != AST::BIN_OP_PLUS) {
                 std::stringstream ss;
-                ss << "Type mismatch: it is not possible to use the binary \033[0m'" << be.op.value <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
+                ss << "Type mismatch: it is not possible to use the binary \033[0m'" << AST::get_binary_op_spelling(be.op) <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
                 throw_exception(SUB_SEMANTIC, ss.str(), be.line, file_name);
             }
-            return Value(AST::Type(AST::TYPE_STRING_LIT, "string"), std::get<7>(left_val.value.value) + std::get<7>(right_val.value.value));
+            string_values.push_back(std::string(std::get<7>(left_val.value.value)) + std::string(std::get<7>(right_val.value.value)));
+            return Value(AST::Type(AST::TYPE_STRING_LIT, "string"), std::string_view(string_values.back()));
         }
-        switch (be.op.type) {
+        switch (be.op) {
             #define VALUE(op, type) Value(output_type, static_cast<type>(binary_two_variants(left_val, right_val, op, be.line)))
-            case TOK_OP_PLUS:
-            case TOK_OP_MINUS:
-            case TOK_OP_MULT:
-            case TOK_OP_DIV:
-            case TOK_OP_MODULO:
-                if (be.op.type >= TOK_OP_PLUS && be.op.type <= TOK_OP_MODULO &&
-                    (be.op.type != TOK_OP_PLUS || left_type.type != AST::TYPE_STRING_LIT || right_type.type != AST::TYPE_STRING_LIT) &&
+            case AST::BIN_OP_PLUS:
+            case AST::BIN_OP_MINUS:
+            case AST::BIN_OP_MULT:
+            case AST::BIN_OP_DIV:
+            case AST::BIN_OP_MODULO:
+                if (be.op >= AST::BIN_OP_PLUS && be.op <= AST::BIN_OP_MODULO &&
+                    (be.op != AST::BIN_OP_PLUS || left_type.type != AST::TYPE_STRING_LIT || right_type.type != AST::TYPE_STRING_LIT) &&
                     (left_type.type > AST::TYPE_DOUBLE || right_type.type > AST::TYPE_DOUBLE)) {
                     std::stringstream ss;
-                    ss << "Type mismatch: it is not possible to use the binary \033[0m'" << be.op.value <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
+                    ss << "Type mismatch: it is not possible to use the binary \033[0m'" << AST::get_binary_op_spelling(be.op) <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
                     throw_exception(SUB_SEMANTIC, ss.str(), be.line, file_name);
                 }
-            case TOK_OP_EQ_EQ:
-            case TOK_OP_NOT_EQ_EQ:
-            case TOK_OP_GT:
-            case TOK_OP_GT_EQ:
-            case TOK_OP_LS:
-            case TOK_OP_LS_EQ:
-                if (be.op.type >= TOK_OP_EQ_EQ) {
+            case AST::BIN_OP_EQ_EQ:
+            case AST::BIN_OP_NOT_EQ_EQ:
+            case AST::BIN_OP_GT:
+            case AST::BIN_OP_GT_EQ:
+            case AST::BIN_OP_LS:
+            case AST::BIN_OP_LS_EQ:
+                if (be.op >= AST::BIN_OP_EQ_EQ) {
                     output_type = AST::Type(AST::TYPE_BOOL, "bool");
                 }
-                if (be.op.type > TOK_OP_NOT_EQ_EQ && (left_type.type > AST::TYPE_DOUBLE || left_type.type == AST::TYPE_BOOL || right_type.type > AST::TYPE_DOUBLE || right_type.type == AST::TYPE_BOOL)) {
+                if (be.op > AST::BIN_OP_NOT_EQ_EQ && (left_type.type > AST::TYPE_DOUBLE || left_type.type == AST::TYPE_BOOL || right_type.type > AST::TYPE_DOUBLE || right_type.type == AST::TYPE_BOOL)) {
                     std::stringstream ss;
-                    ss << "Type mismatch: it is not possible to use the binary \033[0m'" << be.op.value <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
+                    ss << "Type mismatch: it is not possible to use the binary \033[0m'" << AST::get_binary_op_spelling(be.op) <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
                     throw_exception(SUB_SEMANTIC, ss.str(), be.line, file_name);
                 }
-            case TOK_OP_L_AND:
-            case TOK_OP_L_OR:
-                if (be.op.type >= TOK_OP_L_AND && be.op.type <= TOK_OP_L_OR && (left_type.type != AST::TYPE_BOOL || right_type.type != AST::TYPE_BOOL)) {
+            case AST::BIN_OP_L_AND:
+            case AST::BIN_OP_L_OR:
+                if (be.op >= AST::BIN_OP_L_AND && be.op <= AST::BIN_OP_L_OR && (left_type.type != AST::TYPE_BOOL || right_type.type != AST::TYPE_BOOL)) {
                     std::stringstream ss;
-                    ss << "Type mismatch: it is not possible to use the binary \033[0m'" << be.op.value <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
+                    ss << "Type mismatch: it is not possible to use the binary \033[0m'" << AST::get_binary_op_spelling(be.op) <<"'\033[31m operator with \033[0m'" << left_type.to_str() << "'\033[31m and \033[0m'" << right_type.to_str() <<"'\033[31m types";
                     throw_exception(SUB_SEMANTIC, ss.str(), be.line, file_name);
                 }
                 switch (output_type.type) {
                     case AST::TYPE_BOOL:
-                        return VALUE(be.op.type, bool);
+                        return VALUE(be.op, bool);
                     case AST::TYPE_CHAR:
-                        return VALUE(be.op.type, char);
+                        return VALUE(be.op, char);
                     case AST::TYPE_SHORT:
-                        return VALUE(be.op.type, short);
+                        return VALUE(be.op, short);
                     case AST::TYPE_INT:
-                        return VALUE(be.op.type, int);
+                        return VALUE(be.op, int);
                     case AST::TYPE_LONG:
-                        return VALUE(be.op.type, long);
+                        return VALUE(be.op, long);
                     case AST::TYPE_FLOAT:
-                        return VALUE(be.op.type, float);
+                        return VALUE(be.op, float);
                     case AST::TYPE_DOUBLE:
-                        return VALUE(be.op.type, double);
+                        return VALUE(be.op, double);
                 }
             default: {}
             #undef VALUE
@@ -263,35 +286,35 @@ SemanticAnalyzer::Value SemanticAnalyzer::analyze_unary_expr(AST::UnaryExpr& ue)
     Value val = analyze_expr(*ue.expr);
     AST::Type type = val.type;
     
-    switch (ue.op.type) {
+    switch (ue.op) {
         #define VALUE(op, needed_type) Value(type, static_cast<needed_type>(unary_two_variants(val, op, ue.line)))
-        case TOK_OP_MINUS:
-            if (ue.op.type == TOK_OP_MINUS && (type.type > AST::TYPE_DOUBLE || type.type == AST::TYPE_BOOL)) {
+        case AST::UN_OP_MINUS:
+            if (ue.op == AST::UN_OP_MINUS && (type.type > AST::TYPE_DOUBLE || type.type == AST::TYPE_BOOL)) {
                 std::stringstream ss;
-                ss << "Type mismatch: it is not possible to use the unary \033[0m'" << ue.op.value <<"'\033[31m operator with \033[0m'" << type.to_str() << "'\033[31m type";
+                ss << "Type mismatch: it is not possible to use the unary \033[0m'" << AST::get_unary_op_spelling(ue.op) <<"'\033[31m operator with \033[0m'" << type.to_str() << "'\033[31m type";
                 throw_exception(SUB_SEMANTIC, ss.str(), ue.line, file_name);
             }
-        case TOK_OP_L_NOT:
-            if (ue.op.type == TOK_OP_L_NOT && type.type != AST::TYPE_BOOL) {
+        case AST::UN_OP_L_NOT:
+            if (ue.op == AST::UN_OP_L_NOT && type.type != AST::TYPE_BOOL) {
                 std::stringstream ss;
-                ss << "Type mismatch: it is not possible to use the unary \033[0m'" << ue.op.value <<"'\033[31m operator with \033[0m'" << type.to_str() << "'\033[31m type";
+                ss << "Type mismatch: it is not possible to use the unary \033[0m'" << AST::get_unary_op_spelling(ue.op) <<"'\033[31m operator with \033[0m'" << type.to_str() << "'\033[31m type";
                 throw_exception(SUB_SEMANTIC, ss.str(), ue.line, file_name);
             }
             switch (type.type) {
                 case AST::TYPE_BOOL:
-                    return VALUE(ue.op.type, bool);
+                    return VALUE(ue.op, bool);
                 case AST::TYPE_CHAR:
-                    return VALUE(ue.op.type, char);
+                    return VALUE(ue.op, char);
                 case AST::TYPE_SHORT:
-                    return VALUE(ue.op.type, short);
+                    return VALUE(ue.op, short);
                 case AST::TYPE_INT:
-                    return VALUE(ue.op.type, int);
+                    return VALUE(ue.op, int);
                 case AST::TYPE_LONG:
-                    return VALUE(ue.op.type, long);
+                    return VALUE(ue.op, long);
                 case AST::TYPE_FLOAT:
-                    return VALUE(ue.op.type, float);
+                    return VALUE(ue.op, float);
                 case AST::TYPE_DOUBLE:
-                    return VALUE(ue.op.type, double);
+                    return VALUE(ue.op, double);
             }
         default: {}
         #undef VALUE
@@ -345,7 +368,7 @@ SemanticAnalyzer::Value SemanticAnalyzer::get_function_return_value(FunctionInfo
             return val;
         }
         else if (auto ies = dynamic_cast<AST::IfElseStmt*>(&*stmt)) {
-            Value *val = get_function_return_value_from_if_else(*ies);
+            std::unique_ptr<Value> val = get_function_return_value_from_if_else(*ies);
             if (val != nullptr) {
                 variables.pop();
                 return *val;
@@ -357,13 +380,12 @@ SemanticAnalyzer::Value SemanticAnalyzer::get_function_return_value(FunctionInfo
     throw_exception(SUB_SEMANTIC, ss.str(), fce.line, file_name);
 }
 
-SemanticAnalyzer::Value *SemanticAnalyzer::get_function_return_value_from_if_else(AST::IfElseStmt& ies) {
+std::unique_ptr<SemanticAnalyzer::Value> SemanticAnalyzer::get_function_return_value_from_if_else(AST::IfElseStmt& ies) {
     Value cond_val = analyze_expr(*ies.cond);
     if (std::get<bool>(cond_val.value.value) == true) {
         for (auto& stmt : ies.then_block) {
             if (auto rs = dynamic_cast<AST::ReturnStmt*>(&*stmt)) {
-                static Value val = analyze_expr(*rs->expr);
-                return &val;
+                return std::make_unique<Value>(analyze_expr(*rs->expr));
             }
             else if (auto ies = dynamic_cast<AST::IfElseStmt*>(&*stmt)) {
                 return get_function_return_value_from_if_else(*ies);
@@ -373,8 +395,7 @@ SemanticAnalyzer::Value *SemanticAnalyzer::get_function_return_value_from_if_els
     else {
         for (auto& stmt : ies.else_block) {
             if (auto rs = dynamic_cast<AST::ReturnStmt*>(&*stmt)) {
-                static Value val = analyze_expr(*rs->expr);
-                return &val;
+                return std::make_unique<Value>(analyze_expr(*rs->expr));
             }
             else if (auto ies = dynamic_cast<AST::IfElseStmt*>(&*stmt)) {
                 return get_function_return_value_from_if_else(*ies);
@@ -407,7 +428,7 @@ AST::Value SemanticAnalyzer::get_default_val_by_type(AST::Type type, uint32_t li
     }
 }
 
-std::unique_ptr<SemanticAnalyzer::Value> SemanticAnalyzer::get_variable_value(std::string name) {
+std::unique_ptr<SemanticAnalyzer::Value> SemanticAnalyzer::get_variable_value(std::string_view name) {
     auto vars = variables;
     while (!vars.empty()) {
         auto vars_it = vars.top().find(name);
@@ -419,7 +440,7 @@ std::unique_ptr<SemanticAnalyzer::Value> SemanticAnalyzer::get_variable_value(st
     return nullptr;
 }
 
-SemanticAnalyzer::FunctionInfo *SemanticAnalyzer::get_function_info(std::string name) {
+SemanticAnalyzer::FunctionInfo *SemanticAnalyzer::get_function_info(std::string_view name) {
     auto func_it = functions.find(name);
     if (func_it != functions.end()) {
         return &*func_it->second;
@@ -452,7 +473,7 @@ AST::Type SemanticAnalyzer::get_common_type(AST::Type left, AST::Type right, uin
     throw_exception(SUB_SEMANTIC, ss.str(), line, file_name);
 }
 
-double SemanticAnalyzer::binary_two_variants(Value left, Value right, TokenType op, uint32_t line) {
+double SemanticAnalyzer::binary_two_variants(Value left, Value right, AST::BinaryOp op, uint32_t line) {
     double left_val = 0;
     double right_val = 0;
     switch (left.type.type) {
@@ -502,43 +523,43 @@ double SemanticAnalyzer::binary_two_variants(Value left, Value right, TokenType
             break;
     }
     switch (op) {
-        case TOK_OP_PLUS:
+        case AST::BIN_OP_PLUS:
             return left_val + right_val;
-        case TOK_OP_MINUS:
+        case AST::BIN_OP_MINUS:
             return left_val - right_val;
-        case TOK_OP_MULT:
+        case AST::BIN_OP_MULT:
             return left_val * right_val;
-        case TOK_OP_DIV:
+        case AST::BIN_OP_DIV:
             if (right_val == 0) {
                 throw_exception(SUB_SEMANTIC, "Division by zero", line, file_name);
             }
             return left_val / right_val;
-        case TOK_OP_MODULO:
+        case AST::BIN_OP_MODULO:
             return std::fmod(left_val, right_val);
-        case TOK_OP_EQ_EQ:
+        case AST::BIN_OP_EQ_EQ:
             return static_cast<bool>(left_val == right_val);
-        case TOK_OP_NOT_EQ_EQ:
+        case AST::BIN_OP_NOT_EQ_EQ:
             return static_cast<bool>(left_val != right_val);
-        case TOK_OP_GT:
+        case AST::BIN_OP_GT:
             return static_cast<bool>(left_val > right_val);
-        case TOK_OP_GT_EQ:
+        case AST::BIN_OP_GT_EQ:
             return static_cast<bool>(left_val >= right_val);
-        case TOK_OP_LS:
+        case AST::BIN_OP_LS:
             return static_cast<bool>(left_val < right_val);
-        case TOK_OP_LS_EQ:
+        case AST::BIN_OP_LS_EQ:
             return static_cast<bool>(left_val <= right_val);
-        case TOK_OP_L_AND:
+        case AST::BIN_OP_L_AND:
             return static_cast<bool>(left_val && right_val);
-        case TOK_OP_L_OR:
+        case AST::BIN_OP_L_OR:
             return static_cast<bool>(left_val || right_val);
         default:
             std::stringstream ss;
-            ss << "Unsupported binary operator: \033[0m'" << op << "'";
+            ss << "Unsupported binary operator: \033[0m'" << AST::get_binary_op_spelling(op) << "'";
             throw_exception(SUB_SEMANTIC, ss.str(), line, file_name);
     }
 }
 
-double SemanticAnalyzer::unary_two_variants(Value value, TokenType op, uint32_t line) {
+double SemanticAnalyzer::unary_two_variants(Value value, AST::UnaryOp op, uint32_t line) {
     double val = 0;
     switch (value.type.type) {
         case AST::TYPE_BOOL:
@@ -564,13 +585,13 @@ double SemanticAnalyzer::unary_two_variants(Value value, TokenType op, uint32_t
             break;
     }
     switch (op) {
-        case TOK_OP_MINUS:
+        case AST::UN_OP_MINUS:
             return -val;
-        case TOK_OP_L_NOT:
+        case AST::UN_OP_L_NOT:
             return static_cast<bool>(!val);
         default:
             std::stringstream ss;
-            ss << "Unsupported binary operator: \033[0m'" << op << "'";
+            ss << "Unsupported unary operator: \033[0m'" << AST::get_unary_op_spelling(op) << "'";
             throw_exception(SUB_SEMANTIC, ss.str(), line, file_name);
     }
 }
\ No newline at end of file
@@ -0,0 +1,473 @@
+/**
+ * @file server.cpp
+ *
+ * @brief server.hpp implementation
+ */
+
+#include "../../include/server/server.hpp"
+#include "../../include/driver/driver.hpp"
+#include "../../include/target/target.hpp"
+#include <llvm/Support/TargetSelect.h>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+#if !defined(_WIN32)
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+
+extern char **environ;
+
+static constexpr uint32_t MAX_REQUEST_STRINGS = 1 << 16;       /**< Maximum count of strings in one list of request */
+static constexpr uint32_t MAX_REQUEST_LIST_SIZE = 2 << 20;     /**< Maximum total size of strings in one list of request (like ARG_MAX) */
+
+/**
+ * @brief Structure of compile request
+ */
+struct CompileRequest {
+    std::vector<std::string> args;              /**< Command line arguments (without program name) */
+    std::string cwd;                            /**< Working directory of the client */
+    std::vector<std::string> env;               /**< Environment of the client ('NAME=value') */
+    int fds[3] = { -1, -1, -1 };                /**< stdin, stdout and stderr of the client */
+};
+
+/**
+ * @brief Function for writing whole buffer into socket
+ *
+ * @param fd Socket
+ * @param data Buffer
+ * @param size Size of buffer
+ *
+ * @return 'true' if buffer is written and 'false' otherwise
+ */
+static bool write_all(int fd, const void *data, size_t size) {
+    const char *ptr = static_cast<const char*>(data);
+    while (size > 0) {
+        ssize_t n = send(fd, ptr, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Function for reading whole buffer from socket
+ *
+ * @param fd Socket
+ * @param data Buffer
+ * @param size Size of buffer
+ *
+ * @return 'true' if buffer is read and 'false' otherwise
+ */
+static bool read_all(int fd, void *data, size_t size) {
+    char *ptr = static_cast<char*>(data);
+    while (size > 0) {
+        ssize_t n = recv(fd, ptr, size, 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        ptr += n;
+        size -= n;
+    }
+    return true;
+}
+
+/**
+ * @brief Function for writing list of strings into socket (count and size-prefixed strings)
+ *
+ * @param fd Socket
+ * @param strings List of strings
+ *
+ * @return 'true' if list is written and 'false' otherwise
+ */
+static bool write_strings(int fd, const std::vector<std::string>& strings) {
+    uint32_t count = strings.size();
+    if (!write_all(fd, &count, sizeof(count))) {
+        return false;
+    }
+    for (const std::string& str : strings) {
+        uint32_t size = str.size();
+        if (!write_all(fd, &size, sizeof(size)) || !write_all(fd, str.data(), size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Function for reading list of strings written by write_strings from socket
+ *
+ * Lengths come from the client, so list with more than MAX_REQUEST_STRINGS strings or MAX_REQUEST_LIST_SIZE bytes is rejected
+ * before anything is allocated
+ *
+ * @param fd Socket
+ * @param strings List of strings
+ *
+ * @return 'true' if list is read and 'false' otherwise
+ */
+static bool read_strings(int fd, std::vector<std::string>& strings) {
+    uint32_t count;
+    if (!read_all(fd, &count, sizeof(count)) || count > MAX_REQUEST_STRINGS) {
+        return false;
+    }
+    strings.resize(count);
+    uint32_t list_size = 0;
+    for (std::string& str : strings) {
+        uint32_t size;
+        if (!read_all(fd, &size, sizeof(size)) || size > MAX_REQUEST_LIST_SIZE - list_size) {
+            return false;
+        }
+        list_size += size;
+        str.resize(size);
+        if (!read_all(fd, str.data(), size)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Function for passing stdin, stdout and stderr into socket (SCM_RIGHTS)
+ *
+ * @param sock Socket
+ * @param fds File descriptors
+ *
+ * @return 'true' if file descriptors are sent and 'false' otherwise
+ */
+static bool send_fds(int sock, const int fds[3]) {
+    char byte = 0;
+    iovec iov{ .iov_base = &byte, .iov_len = 1 };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 3)] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * 3);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * 3);
+    return sendmsg(sock, &msg, MSG_NOSIGNAL) == 1;
+}
+
+/**
+ * @brief Function for receiving file descriptors sent by send_fds from socket
+ *
+ * @param sock Socket
+ * @param fds Received file descriptors
+ *
+ * @return 'true' if file descriptors are received and 'false' otherwise
+ */
+static bool recv_fds(int sock, int fds[3]) {
+    char byte;
+    iovec iov{ .iov_base = &byte, .iov_len = 1 };
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int) * 3)] = {};
+    msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(sock, &msg, 0) != 1) {
+        return false;
+    }
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg == nullptr || cmsg->cmsg_type != SCM_RIGHTS || cmsg->cmsg_len != CMSG_LEN(sizeof(int) * 3)) {
+        return false;
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * 3);
+    return true;
+}
+
+/**
+ * @brief Function for making address of Unix socket
+ *
+ * @param socket_path Path to the Unix socket
+ * @param addr Address
+ *
+ * @return 'true' if address is made and 'false' if path is too long
+ */
+static bool make_socket_address(const std::string& socket_path, sockaddr_un& addr) {
+    if (socket_path.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+    return true;
+}
+
+/**
+ * @brief Function for checking that the client runs as the same user as the server
+ *
+ * Request carries environment and working directory of the client (including 'TOPAZC_LINKER', which is executed), so only the owner
+ * of the server may use it
+ *
+ * @param client Socket of the client
+ *
+ * @return 'true' if the client is trusted and 'false' otherwise
+ */
+static bool is_trusted_peer(int client) {
+#if defined(__linux__)
+    ucred cred;
+    socklen_t cred_size = sizeof(cred);
+    if (getsockopt(client, SOL_SOCKET, SO_PEERCRED, &cred, &cred_size) != 0) {
+        return false;
+    }
+    return cred.uid == getuid();
+#else
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(client, &uid, &gid) != 0) {
+        return false;
+    }
+    return uid == getuid();
+#endif
+}
+
+/**
+ * @brief Function for removing stale socket before binding
+ *
+ * Only socket may be removed: path given by mistake (for example a source file) is reported instead of being deleted
+ *
+ * @param socket_path Path to the socket
+ *
+ * @return 'true' if the path is free and 'false' otherwise
+ */
+static bool remove_stale_socket(const std::string& socket_path) {
+    struct stat st;
+    if (lstat(socket_path.c_str(), &st) != 0) {
+        if (errno == ENOENT) {
+            return true;
+        }
+        std::cerr << "\033[31mServer error: Failed to check \033[0m'" << socket_path << "'\033[31m: " << strerror(errno) << "\033[0m\n";
+        return false;
+    }
+    if (!S_ISSOCK(st.st_mode)) {
+        std::cerr << "\033[31mServer error: \033[0m'" << socket_path << "'\033[31m exists and is not a socket\033[0m\n";
+        return false;
+    }
+    if (unlink(socket_path.c_str()) != 0) {
+        std::cerr << "\033[31mServer error: Failed to remove stale socket \033[0m'" << socket_path << "'\033[31m: " << strerror(errno) << "\033[0m\n";
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Function for compiling request in the current (forked) process
+ *
+ * @param request Compile request
+ *
+ * @return Exit code of the compilation
+ */
+static int compile_request(CompileRequest& request) {
+    for (int i = 0; i < 3; i++) {
+        dup2(request.fds[i], i);
+        close(request.fds[i]);
+    }
+    if (chdir(request.cwd.c_str()) != 0) {
+        std::cerr << "\033[31mCompilation error: Failed to change directory to \033[0m'" << request.cwd << "'\n";
+        return 1;
+    }
+    clearenv();
+    for (std::string& var : request.env) {
+        putenv(var.data());
+    }
+
+    std::vector<const char*> argv = { "topazc" };
+    for (const std::string& arg : request.args) {
+        argv.push_back(arg.c_str());
+    }
+    argv.push_back(nullptr);
+    CompilerOptions options;
+    if (!parse_options(argv.size() - 1, argv.data(), options)) {
+        return 1;
+    }
+    Driver driver(options);
+    return driver.run();
+}
+
+/**
+ * @brief Function for handling one client connection
+ *
+ * Handler forks the worker which compiles the request, because the request changes working directory, environment and standard
+ * streams of the whole process. Worker reports its exit code to the client through the handler
+ *
+ * @param client Socket of the client
+ *
+ * @return Exit code of the handler
+ */
+static int handle_client(int client) {
+    CompileRequest request;
+    std::vector<std::string> cwd;
+    if (!read_strings(client, request.args) || !read_strings(client, cwd) || cwd.size() != 1 || !read_strings(client, request.env)
+        || !recv_fds(client, request.fds)) {
+        return 1;
+    }
+    request.cwd = cwd[0];
+
+    pid_t worker = fork();
+    if (worker < 0) {
+        return 1;
+    }
+    if (worker == 0) {
+        close(client);
+        int exit_code = compile_request(request);
+        std::cout.flush();
+        std::cerr.flush();
+        exit(exit_code);
+    }
+    for (int fd : request.fds) {
+        close(fd);
+    }
+
+    int status = 0;
+    while (waitpid(worker, &status, 0) < 0) {
+        if (errno != EINTR) {
+            return 1;
+        }
+    }
+    int32_t exit_code = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    write_all(client, &exit_code, sizeof(exit_code));
+    return 0;
+}
+
+int run_server(const std::string& socket_path) {
+    llvm::InitializeNativeTarget();
+    llvm::InitializeNativeTargetAsmPrinter();
+    llvm::InitializeNativeTargetAsmParser();
+
+    TargetConfig host_config;
+    resolve_target_config(host_config);
+    TargetConfig native_config;
+    native_config.native = true;
+    resolve_target_config(native_config);
+    for (OptLevel level : { OPT_O0, OPT_O1, OPT_O2, OPT_O3, OPT_OS, OPT_OZ }) {
+        std::string error;
+        release_target_machine(host_config, level, create_target_machine(host_config, level, error));
+        release_target_machine(native_config, level, create_target_machine(native_config, level, error));
+    }
+
+    sockaddr_un addr;
+    if (!make_socket_address(socket_path, addr)) {
+        std::cerr << "\033[31mServer error: Socket path is too long: \033[0m'" << socket_path << "'\n";
+        return 1;
+    }
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0) {
+        std::cerr << "\033[31mServer error: Failed to create socket: " << strerror(errno) << "\033[0m\n";
+        return 1;
+    }
+    if (!remove_stale_socket(socket_path)) {
+        close(sock);
+        return 1;
+    }
+    // socket is created accessible only by the owner, so other users can not even connect
+    mode_t old_umask = umask(0077);
+    int bound = bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    umask(old_umask);
+    if (bound != 0 || chmod(socket_path.c_str(), 0600) != 0 || listen(sock, SOMAXCONN) != 0) {
+        std::cerr << "\033[31mServer error: Failed to listen on \033[0m'" << socket_path << "'\033[31m: " << strerror(errno) << "\033[0m\n";
+        close(sock);
+        return 1;
+    }
+
+    // handlers are never waited by the server, so they should be reaped automatically
+    signal(SIGCHLD, SIG_IGN);
+    std::cout << "Server is listening on " << socket_path << std::endl;
+
+    while (1) {
+        int client = accept(sock, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;
+            }
+            std::cerr << "\033[31mServer error: Failed to accept connection: " << strerror(errno) << "\033[0m\n";
+            close(sock);
+            return 1;
+        }
+        if (!is_trusted_peer(client)) {
+            close(client);
+            continue;
+        }
+        pid_t handler = fork();
+        if (handler == 0) {
+            close(sock);
+            signal(SIGCHLD, SIG_DFL);
+            _exit(handle_client(client));
+        }
+        close(client);
+    }
+}
+
+bool run_client(const std::string& socket_path, int argc, const char *argv[], int& exit_code) {
+    sockaddr_un addr;
+    if (!make_socket_address(socket_path, addr)) {
+        return false;
+    }
+    int sock = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (sock < 0) {
+        return false;
+    }
+    if (connect(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0) {
+        close(sock);
+        return false;
+    }
+
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--connect=", 10) != 0) {
+            args.push_back(argv[i]);
+        }
+    }
+    char *cwd_ptr = getcwd(nullptr, 0);
+    std::vector<std::string> cwd = { cwd_ptr ? cwd_ptr : "." };
+    free(cwd_ptr);
+    std::vector<std::string> env;
+    for (char **var = environ; *var != nullptr; var++) {
+        if (strncmp(*var, "TOPAZC_SERVER=", 14) != 0) {
+            env.push_back(*var);
+        }
+    }
+    int fds[3] = { STDIN_FILENO, STDOUT_FILENO, STDERR_FILENO };
+    if (!write_strings(sock, args) || !write_strings(sock, cwd) || !write_strings(sock, env) || !send_fds(sock, fds)) {
+        close(sock);
+        return false;
+    }
+
+    int32_t code;
+    if (!read_all(sock, &code, sizeof(code))) {
+        std::cerr << "\033[31mCompilation error: Compile server closed connection without exit code\033[0m\n";
+        code = 1;
+    }
+    close(sock);
+    exit_code = code;
+    return true;
+}
+#else
+int run_server(const std::string& socket_path) {
+    std::cerr << "\033[31mServer error: Compile server is unsupported on Windows\033[0m\n";
+    return 1;
+}
+
+bool run_client(const std::string& socket_path, int argc, const char *argv[], int& exit_code) {
+    return false;
+}
+#endif
@@ -0,0 +1,17 @@
+/**
+ * @file source.cpp
+ *
+ * @brief source.hpp implementation
+ */
+
+#include "../../include/source/source.hpp"
+#include <limits>
+
+bool SourceManager::add_file(std::string name, std::string_view text, uint16_t& file_id) {
+    if (files.size() > std::numeric_limits<uint16_t>::max() || text.size() > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+    file_id = files.size();
+    files.push_back({ std::move(name), text });
+    return true;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file target.cpp
+ *
+ * @brief target.hpp implementation
+ */
+
+#include "../../include/target/target.hpp"
+#include <llvm/TargetParser/SubtargetFeature.h>
+#include <llvm/Target/TargetOptions.h>
+#include <llvm/MC/TargetRegistry.h>
+#include <llvm/TargetParser/Triple.h>
+#include <llvm/TargetParser/Host.h>
+#include <optional>
+#include <cstdlib>
+#include <mutex>
+#include <tuple>
+#include <map>
+
+/**
+ * @brief Key of target machines pool (triple, CPU, features, optimization level)
+ */
+using TargetMachineKey = std::tuple<std::string, std::string, std::string, OptLevel>;
+
+static std::mutex target_machines_mutex;                                                          /**< Mutex of target machines pool */
+static std::multimap<TargetMachineKey, std::unique_ptr<llvm::TargetMachine>> target_machines;     /**< Pool of released target machines */
+
+std::string get_host_triple() {
+    const char *env_triple = std::getenv("TOPAZ_TRIPLE");
+    if (env_triple && *env_triple) {
+        return std::string(env_triple);
+    }
+    return llvm::sys::getProcessTriple();
+}
+
+void resolve_target_config(TargetConfig& config) {
+    if (config.triple.empty()) {
+        config.triple = get_host_triple();
+    }
+    if (config.cpu == "native") {
+        config.native = true;
+    }
+    if (!config.native) {
+        return;
+    }
+
+    static const std::string host_cpu = llvm::sys::getHostCPUName().str();
+    static const std::string host_features = []() {
+        llvm::SubtargetFeatures features;
+        for (const auto& feature : llvm::sys::getHostCPUFeatures()) {
+            features.AddFeature(feature.getKey(), feature.getValue());
+        }
+        return features.getString();
+    }();
+
+    config.cpu = host_cpu;
+    llvm::SubtargetFeatures features(host_features);
+    if (!config.features.empty()) {
+        llvm::SmallVector<llvm::StringRef> user_features;
+        llvm::StringRef(config.features).split(user_features, ',', -1, false);
+        for (llvm::StringRef feature : user_features) {
+            features.AddFeature(feature);
+        }
+    }
+    config.features = features.getString();
+}
+
+std::unique_ptr<llvm::TargetMachine> create_target_machine(const TargetConfig& config, OptLevel level, std::string& error) {
+    const llvm::Target *target = llvm::TargetRegistry::lookupTarget(config.triple, error);
+    if (!target) {
+        return nullptr;
+    }
+
+    llvm::TargetOptions opt;
+    auto reloc_model = std::optional<llvm::Reloc::Model>();
+    std::unique_ptr<llvm::TargetMachine> target_machine(target->createTargetMachine(config.triple, config.cpu, config.features, opt, reloc_model, std::nullopt, Optimizer::get_codegen_opt_level(level)));
+    if (!target_machine) {
+        error = "Failed to create TargetMachine for triple '" + config.triple + "'";
+    }
+    return target_machine;
+}
+
+std::unique_ptr<llvm::TargetMachine> acquire_target_machine(const TargetConfig& config, OptLevel level, std::string& error) {
+    {
+        std::lock_guard<std::mutex> lock(target_machines_mutex);
+        auto target_machine_it = target_machines.find({config.triple, config.cpu, config.features, level});
+        if (target_machine_it != target_machines.end()) {
+            std::unique_ptr<llvm::TargetMachine> target_machine = std::move(target_machine_it->second);
+            target_machines.erase(target_machine_it);
+            return target_machine;
+        }
+    }
+    return create_target_machine(config, level, error);
+}
+
+void release_target_machine(const TargetConfig& config, OptLevel level, std::unique_ptr<llvm::TargetMachine> target_machine) {
+    if (target_machine == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(target_machines_mutex);
+    target_machines.emplace(TargetMachineKey{config.triple, config.cpu, config.features, level}, std::move(target_machine));
+}